@@ -0,0 +1,123 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+#include <new>
+
+// Unnamed namespace
+namespace
+{
+    // Constant initialized, so allocations made during static initialization are counted too
+    std::atomic<size_t> gAllocationCount{ 0 };
+    std::atomic<size_t> gAllocatedBytes{ 0 };
+}
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// ##################
+// # Getter methods #
+// ##################
+
+
+bool AllocationCounter::isEnabled()
+{
+#ifdef COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationSnapshot AllocationCounter::getSnapshot()
+{
+    AllocationSnapshot snapshot;
+    snapshot.allocations = gAllocationCount.load(std::memory_order_relaxed);
+    snapshot.bytes = gAllocatedBytes.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+AllocationSnapshot AllocationCounter::getAllocationsSince(const AllocationSnapshot& since)
+{
+    AllocationSnapshot now = getSnapshot();
+    now.allocations -= since.allocations;
+    now.bytes -= since.bytes;
+    return now;
+}
+
+
+// ################################
+// # Global operator replacements #
+// ################################
+
+
+#ifdef COUNT_ALLOCATIONS
+// The array, nothrow and sized forms forward to these by default
+void* operator new(size_t size)
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+// Over-aligned allocations, also used by std::pmr::new_delete_resource on some standard libraries
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    gAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+    size_t alignmentBytes = static_cast<size_t>(alignment);
+    size_t alignedSize = ((size == 0 ? 1 : size) + alignmentBytes - 1) / alignmentBytes * alignmentBytes;
+#ifdef _MSC_VER
+    void* memory = _aligned_malloc(alignedSize, alignmentBytes);
+#else
+    void* memory = std::aligned_alloc(alignmentBytes, alignedSize);
+#endif
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+#ifdef _MSC_VER
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+void operator delete(void* memory, size_t, std::align_val_t alignment) noexcept
+{
+    operator delete(memory, alignment);
+}
+#endif
@@ -0,0 +1,58 @@
+// AllocationCounter.h
+#pragma once
+
+#include <cstddef>
+
+/**
+ * Struct representing the heap allocations counted up to a point in time.
+ * Subtract two snapshots to get the allocations made between them.
+ */
+struct AllocationSnapshot {
+    size_t allocations = 0;             // Number of calls to global operator new
+    size_t bytes = 0;                   // Bytes requested from global operator new
+};
+
+/**
+ * Class representing the counter of heap allocations made through global operator new, for checking
+ * that hot paths allocate nothing. Counting replaces global operator new and delete, so it is only
+ * compiled in when COUNT_ALLOCATIONS is defined (Debug builds), otherwise every snapshot is zero.
+ */
+class AllocationCounter {
+public:
+    // Prevent construction, the counter is global
+    AllocationCounter() = delete;
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Check if allocation counting is compiled in.
+     *
+     * @return True if COUNT_ALLOCATIONS is defined.
+     */
+    static bool isEnabled();
+
+    /**
+     * Get the allocations counted since startup, from every thread.
+     *
+     * @return The allocation snapshot.
+     */
+    static AllocationSnapshot getSnapshot();
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Get the allocations made since an earlier snapshot.
+     *
+     * @param since The earlier snapshot.
+     * @return The allocations made after the snapshot was taken.
+     */
+    static AllocationSnapshot getAllocationsSince(const AllocationSnapshot& since);
+};
@@ -1,4 +1,5 @@
 #include "BackScratcherMesh.h"
+#include "CompositeMeshBuilder.h"
 #include "PyramidMesh.h"
 #include "CubeMesh.h"
 #include "CubeLightMesh.h"
@@ -22,12 +23,12 @@
 
 
 BackScratcherMesh::BackScratcherMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, glm::vec3 scale, glm::vec3 rotationDegrees, glm::vec3 translation, RotationOrder rotationOrder, GLuint shaderProgramId, int sectorCount)
-    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), sectorCount(sectorCount)
+    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), sectorCount(sectorCount), fullSectorCount(sectorCount)
 {
 }
 
 BackScratcherMesh::BackScratcherMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, GLuint shaderProgramId, int sectorCount)
-    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), sectorCount(sectorCount)
+    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), sectorCount(sectorCount), fullSectorCount(sectorCount)
 {
 }
 
@@ -67,7 +68,8 @@ void BackScratcherMesh::generateVertices()
 
     float meshLength = 0.0f;
 
-    std::vector<Mesh*> meshes;
+    // Parts are generated untransformed, then built into the buffers with their transforms in one pass
+    CompositeMeshBuilder builder(vertexMode);
 
     // Handle
     CylinderMesh rubberGrip(vertexMode, UnitOfMeasure::CENTIMETER, -1, rubberGripRadius, rubberGripLength, sectorCount);
@@ -75,8 +77,7 @@ void BackScratcherMesh::generateVertices()
     rubberGrip.translateMesh(0.0f, meshLength + (rubberGripLength / 2.0f), 0.0f);
     rubberGrip.setColor(color);
     rubberGrip.generateVertices();
-    rubberGrip.translateMeshPreVAO();
-    meshes.push_back(&rubberGrip);
+    builder.addPart(rubberGrip);
     meshLength += rubberGripLength;
 
     CylinderMesh tube1(vertexMode, UnitOfMeasure::CENTIMETER, -1, tube1Radius, tube1Length, sectorCount);
@@ -84,8 +85,7 @@ void BackScratcherMesh::generateVertices()
     tube1.translateMesh(0.0f, meshLength + (tube1Length / 2.0f), 0.0f);
     tube1.setColor(color);
     tube1.generateVertices();
-    tube1.translateMeshPreVAO();
-    meshes.push_back(&tube1);
+    builder.addPart(tube1);
     meshLength += tube1Length;
 
     CylinderMesh tube2(vertexMode, UnitOfMeasure::CENTIMETER, -1, tube2Radius, tube2Length, sectorCount);
@@ -93,8 +93,7 @@ void BackScratcherMesh::generateVertices()
     tube2.translateMesh(0.0f, meshLength + (tube2Length / 2.0f), 0.0f);
     tube2.setColor(color);
     tube2.generateVertices();
-    tube2.translateMeshPreVAO();
-    meshes.push_back(&tube2);
+    builder.addPart(tube2);
     meshLength += tube2Length;
 
     CylinderMesh tube3(vertexMode, UnitOfMeasure::CENTIMETER, -1, tube3Radius, tube3Length, sectorCount);
@@ -102,8 +101,7 @@ void BackScratcherMesh::generateVertices()
     tube3.translateMesh(0.0f, meshLength + (tube3Length / 2.0f), 0.0f);
     tube3.setColor(color);
     tube3.generateVertices();
-    tube3.translateMeshPreVAO();
-    meshes.push_back(&tube3);
+    builder.addPart(tube3);
     meshLength += tube3Length;
 
     CylinderMesh tube4(vertexMode, UnitOfMeasure::CENTIMETER, -1, tube4Radius, tube4Length, sectorCount);
@@ -111,8 +109,7 @@ void BackScratcherMesh::generateVertices()
     tube4.translateMesh(0.0f, meshLength + (tube4Length / 2.0f), 0.0f);
     tube4.setColor(color);
     tube4.generateVertices();
-    tube4.translateMeshPreVAO();
-    meshes.push_back(&tube4);
+    builder.addPart(tube4);
     meshLength += tube4Length;
 
     CylinderMesh pawConnector(vertexMode, UnitOfMeasure::CENTIMETER, -1, pawConnectorRadius, pawConnectorLength, sectorCount);
@@ -120,8 +117,7 @@ void BackScratcherMesh::generateVertices()
     pawConnector.translateMesh(0.0f, meshLength + (pawConnectorLength / 2.0f), 0.0f);
     pawConnector.setColor(color);
     pawConnector.generateVertices();
-    pawConnector.translateMeshPreVAO();
-    meshes.push_back(&pawConnector);
+    builder.addPart(pawConnector);
     meshLength += pawConnectorLength;
 
     // Head
@@ -131,8 +127,7 @@ void BackScratcherMesh::generateVertices()
     paw.rotateMesh(90.0f, 0.0f, 0.0f);
     paw.setColor(color);
     paw.generateVertices();
-    paw.translateMeshPreVAO();
-    meshes.push_back(&paw);
+    builder.addPart(paw);
     meshLength += (pawRadius * 2.0f);
 
     CubeMesh clawCenter(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawHeight, clawLength);
@@ -140,8 +135,7 @@ void BackScratcherMesh::generateVertices()
     clawCenter.translateMesh(0.0f, meshLength - (clawHeight / 2.0f), (pawThickness / 2.0f) + (clawLength / 2.0f));
     clawCenter.setColor(color);
     clawCenter.generateVertices();
-    clawCenter.translateMeshPreVAO();
-    meshes.push_back(&clawCenter);
+    builder.addPart(clawCenter);
 
     PyramidMesh clawCenterTip(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawTipLength, clawHeight);
     clawCenterTip.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -149,8 +143,7 @@ void BackScratcherMesh::generateVertices()
     clawCenterTip.translateMesh(0.0f, meshLength - (clawHeight / 2.0f), (pawThickness / 2.0f) + clawLength + (clawTipLength / 2.0f));
     clawCenterTip.setColor(color);
     clawCenterTip.generateVertices();
-    clawCenterTip.translateMeshPreVAO();
-    meshes.push_back(&clawCenterTip);
+    builder.addPart(clawCenterTip);
 
     CubeMesh clawLeft1(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawHeight, clawLength);
     clawLeft1.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -158,8 +151,7 @@ void BackScratcherMesh::generateVertices()
     clawLeft1.translateMesh(-(pawRadius / 2.5f), meshLength - (clawHeight / 2.0f) - 0.25f, (pawThickness / 2.0f) + (clawLength / 2.0f));
     clawLeft1.setColor(color);
     clawLeft1.generateVertices();
-    clawLeft1.translateMeshPreVAO();
-    meshes.push_back(&clawLeft1);
+    builder.addPart(clawLeft1);
 
     PyramidMesh clawLeft1Tip(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawTipLength, clawHeight);
     clawLeft1Tip.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -167,8 +159,7 @@ void BackScratcherMesh::generateVertices()
     clawLeft1Tip.translateMesh(-(pawRadius / 2.5f), meshLength - (clawHeight / 2.0f) - 0.25f, (pawThickness / 2.0f) + clawLength + (clawTipLength / 2.0f));
     clawLeft1Tip.setColor(color);
     clawLeft1Tip.generateVertices();
-    clawLeft1Tip.translateMeshPreVAO();
-    meshes.push_back(&clawLeft1Tip);
+    builder.addPart(clawLeft1Tip);
 
     CubeMesh clawLeft2(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawHeight, clawLength);
     clawLeft2.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -176,8 +167,7 @@ void BackScratcherMesh::generateVertices()
     clawLeft2.translateMesh(-(pawRadius / 1.25f - 0.25f), meshLength - (clawHeight / 2.0f) - 1.0f, (pawThickness / 2.0f) + (clawLength / 2.0f));
     clawLeft2.setColor(color);
     clawLeft2.generateVertices();
-    clawLeft2.translateMeshPreVAO();
-    meshes.push_back(&clawLeft2);
+    builder.addPart(clawLeft2);
 
     PyramidMesh clawLeftTip2Tip(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawTipLength, clawHeight);
     clawLeftTip2Tip.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -185,8 +175,7 @@ void BackScratcherMesh::generateVertices()
     clawLeftTip2Tip.translateMesh(-(pawRadius / 1.25f - 0.25f), meshLength - (clawHeight / 2.0f) - 1.0f, (pawThickness / 2.0f) + clawLength + (clawTipLength / 2.0f));
     clawLeftTip2Tip.setColor(color);
     clawLeftTip2Tip.generateVertices();
-    clawLeftTip2Tip.translateMeshPreVAO();
-    meshes.push_back(&clawLeftTip2Tip);
+    builder.addPart(clawLeftTip2Tip);
 
     CubeMesh clawRight1(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawHeight, clawLength);
     clawRight1.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -194,8 +183,7 @@ void BackScratcherMesh::generateVertices()
     clawRight1.translateMesh((pawRadius / 2.5f), meshLength - (clawHeight / 2.0f) - 0.25f, (pawThickness / 2.0f) + (clawLength / 2.0f));
     clawRight1.setColor(color);
     clawRight1.generateVertices();
-    clawRight1.translateMeshPreVAO();
-    meshes.push_back(&clawRight1);
+    builder.addPart(clawRight1);
 
     PyramidMesh clawRight1Tip(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawTipLength, clawHeight);
     clawRight1Tip.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -203,8 +191,7 @@ void BackScratcherMesh::generateVertices()
     clawRight1Tip.translateMesh((pawRadius / 2.5f), meshLength - (clawHeight / 2.0f) - 0.25f, (pawThickness / 2.0f) + clawLength + (clawTipLength / 2.0f));
     clawRight1Tip.setColor(color);
     clawRight1Tip.generateVertices();
-    clawRight1Tip.translateMeshPreVAO();
-    meshes.push_back(&clawRight1Tip);
+    builder.addPart(clawRight1Tip);
 
     CubeMesh clawRight2(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawHeight, clawLength);
     clawRight2.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -212,8 +199,7 @@ void BackScratcherMesh::generateVertices()
     clawRight2.translateMesh((pawRadius / 1.25f - 0.25f), meshLength - (clawHeight / 2.0f) - 1.0f, (pawThickness / 2.0f) + (clawLength / 2.0f));
     clawRight2.setColor(color);
     clawRight2.generateVertices();
-    clawRight2.translateMeshPreVAO();
-    meshes.push_back(&clawRight2);
+    builder.addPart(clawRight2);
 
     PyramidMesh clawRightTip2Tip(vertexMode, UnitOfMeasure::CENTIMETER, -1, clawWidth, clawTipLength, clawHeight);
     clawRightTip2Tip.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -221,26 +207,11 @@ void BackScratcherMesh::generateVertices()
     clawRightTip2Tip.translateMesh((pawRadius / 1.25f - 0.25f), meshLength - (clawHeight / 2.0f) - 1.0f, (pawThickness / 2.0f) + clawLength + (clawTipLength / 2.0f));
     clawRightTip2Tip.setColor(color);
     clawRightTip2Tip.generateVertices();
-    clawRightTip2Tip.translateMeshPreVAO();
-    meshes.push_back(&clawRightTip2Tip);
+    builder.addPart(clawRightTip2Tip);
 
 
 
 
-    int verticesAdded = 0;
-
-    for (Mesh* meshPtr : meshes) {
-        for (GLfloat vertexValue : meshPtr->getVertexBuffer()) {
-            vertexBuffer.push_back(vertexValue);
-        }
-
-        for (GLuint elementValue : meshPtr->getElementBuffer()) {
-            elementBuffer.push_back(elementValue + verticesAdded);
-        }
-
-        verticesAdded = getVertexBufferCount();
-    }
-
     // Store any existing transformations
     glm::mat4 scaleTemp = scale;
     glm::mat4 rotationTemp = rotation;
@@ -253,7 +224,8 @@ void BackScratcherMesh::generateVertices()
 
     // Transform the headset to start at a resting position where the origin is at the center and bottom of the mesh
     translateMesh(0.0f, -(meshLength / 2.0f), 0.0f);
-    translateMeshPreVAO();
+    glm::mat4 centerTransform = getModel();
+    setTranslation(Mesh::DEFAULT_TRANSLATION_VEC3);
 
     rotateMesh(0.0f, 90.0f, 90.2f, RotationOrder::Y_Z_X);
     translateMesh(0.0f, rubberGripRadius - 0.05f, 0.0f);
@@ -263,10 +235,16 @@ void BackScratcherMesh::generateVertices()
         scaleMesh(cmToInch, cmToInch, cmToInch);
     }
 
-    translateMeshPreVAO();
+    builder.build(vertexBuffer, elementBuffer, getModel() * centerTransform);
 
     // Set back any existing transformations
     scale = scaleTemp;
     rotation = rotationTemp;
     translation = translationTemp;
+}
+
+float BackScratcherMesh::setDetailLevel(int level)
+{
+    sectorCount = getLODSectorCount(fullSectorCount, level);
+    return 2.0f * glm::pi<float>() / sectorCount;
 }
\ No newline at end of file
@@ -50,10 +50,25 @@ public:
      */
     void generateVertices() override;
 
+protected:
+    // ############################
+    // # Virtual method overrides #
+    // ############################
+
+
+    /**
+     * Set the detail the vertices are generated with, each level halving the sectors around curved back scratcher sections.
+     *
+     * @param level The level of detail (0 = the detail the back scratcher was created with).
+     * @return The angle between neighboring sectors at the level in radians.
+     */
+    float setDetailLevel(int level) override;
+
 private:
     // #############
     // # Variables #
     // #############
 
     int sectorCount;    // The number of sectors around curved controller sections (greater = more triangles and detail)
+    int fullSectorCount; // The number of sectors the back scratcher was created with (full detail)
 };
\ No newline at end of file
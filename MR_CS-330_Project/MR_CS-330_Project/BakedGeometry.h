@@ -0,0 +1,200 @@
+// BakedGeometry.h
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <cstddef>
+
+/**
+ * Struct representing a vertex of a unit-size shape, positions span -0.5 to 0.5 on each axis the shape has.
+ * Corners shared by faces leave the UV and normal zero.
+ */
+struct BakedVertex {
+    GLfloat x = 0.0f, y = 0.0f, z = 0.0f;       // Position of the unit-size shape
+    GLfloat u = 0.0f, v = 0.0f;                 // Texture UV before clamping
+    GLfloat nx = 0.0f, ny = 0.0f, nz = 0.0f;    // Outward normal of the face on the unit-size shape, not normalized
+};
+
+/**
+ * Struct representing the vertices and elements of a fixed topology shape, built at compile time.
+ * Meshes scale the positions and normals by their size and clamp the UVs, the only per-instance work.
+ */
+template <size_t VERTEX_COUNT, size_t ELEMENT_COUNT>
+struct BakedShape {
+    std::array<BakedVertex, VERTEX_COUNT> vertices;     // Unit-size vertices
+    std::array<GLuint, ELEMENT_COUNT> elements;         // Elements of the triangles
+};
+
+// Compile time tables of the fixed topology meshes
+namespace BakedGeometry
+{
+    using UVs = std::array<GLfloat, 2>;
+
+    /**
+     * Give each triangle corner its own vertex, so corners shared by faces can have a UV and normal per face.
+     * Normals are the cross product of the triangle edges, flipped to point away from the center as
+     * Mesh::calculateNormal does, so they stay outward at any positive size.
+     *
+     * @param corners The shared corners of the shape.
+     * @param cornerElements The corner of each triangle vertex, 3 per triangle.
+     * @param uvs The UV of each triangle vertex.
+     * @return The shape with a vertex per element, in element order.
+     */
+    template <size_t CORNER_COUNT, size_t COUNT>
+    constexpr BakedShape<COUNT, COUNT> unweld(const std::array<BakedVertex, CORNER_COUNT>& corners, const std::array<GLuint, COUNT>& cornerElements, const std::array<UVs, COUNT>& uvs)
+    {
+        static_assert(COUNT % 3 == 0, "Baked shapes are made of whole triangles");
+
+        BakedShape<COUNT, COUNT> shape = {};
+        for (size_t i = 0; i < COUNT; i += 3) {
+            const BakedVertex& corner1 = corners[cornerElements[i]];
+            const BakedVertex& corner2 = corners[cornerElements[i + 1]];
+            const BakedVertex& corner3 = corners[cornerElements[i + 2]];
+
+            GLfloat edge1x = corner2.x - corner1.x, edge1y = corner2.y - corner1.y, edge1z = corner2.z - corner1.z;
+            GLfloat edge2x = corner3.x - corner1.x, edge2y = corner3.y - corner1.y, edge2z = corner3.z - corner1.z;
+            GLfloat nx = edge1y * edge2z - edge1z * edge2y;
+            GLfloat ny = edge1z * edge2x - edge1x * edge2z;
+            GLfloat nz = edge1x * edge2y - edge1y * edge2x;
+            if (nx * -corner1.x + ny * -corner1.y + nz * -corner1.z >= 0.0f) {
+                nx = -nx;
+                ny = -ny;
+                nz = -nz;
+            }
+
+            for (size_t j = i; j < i + 3; ++j) {
+                const BakedVertex& corner = corners[cornerElements[j]];
+                shape.vertices[j] = { corner.x, corner.y, corner.z, uvs[j][0], uvs[j][1], nx, ny, nz };
+                shape.elements[j] = static_cast<GLuint>(j);
+            }
+        }
+        return shape;
+    }
+
+    constexpr GLfloat ONE_THIRD = 1.0f / 3.0f;
+    constexpr GLfloat TWO_THIRDS = 2.0f / 3.0f;
+
+
+    // ########
+    // # Cube #
+    // ########
+
+
+    // Corners shared by every face, for modes without UVs
+    constexpr BakedShape<8, 36> CUBE_CORNERS = {
+        {{
+            // Bottom Corners
+            { -0.5f, -0.5f,  0.5f },   // Left, Bottom, Front
+            { -0.5f, -0.5f, -0.5f },   // Left, Bottom, Back
+            {  0.5f, -0.5f, -0.5f },   // Right, Bottom, Back
+            {  0.5f, -0.5f,  0.5f },   // Right, Bottom, Front
+
+            // Top Corners
+            { -0.5f,  0.5f,  0.5f },   // Left, Top, Front
+            { -0.5f,  0.5f, -0.5f },   // Left, Top, Back
+            {  0.5f,  0.5f, -0.5f },   // Right, Top, Back
+            {  0.5f,  0.5f,  0.5f },   // Right, Top, Front
+        }},
+        {
+            0, 1, 2,    // Triangle 1 - Bottom: Left, Back
+            0, 3, 2,    // Triangle 2 - Bottom: Right, Front
+            4, 0, 3,    // Triangle 3 - Front: Bottom, Left
+            4, 7, 3,    // Triangle 4 - Front: Top, Right
+            5, 1, 0,    // Triangle 5 - Left: Back, Bottom
+            5, 4, 0,    // Triangle 6 - Left: Front, Top
+            6, 2, 1,    // Triangle 7 - Back: Bottom, Right
+            6, 5, 1,    // Triangle 8 - Back: Top, Left
+            7, 3, 2,    // Triangle 9 - Right: Front, Bottom
+            7, 6, 2,    // Triangle 10 - Right: Back, Top
+            5, 4, 7,    // Triangle 11 - Top: Front, Left
+            5, 6, 7     // Triangle 12 - Top: Back, Right
+        }
+    };
+
+    // A vertex per triangle corner, the faces unwrapped into thirds of the texture
+    constexpr BakedShape<36, 36> CUBE_FACES = unweld(CUBE_CORNERS.vertices, CUBE_CORNERS.elements, std::array<UVs, 36>{{
+        { 0.0f, 0.5f }, { ONE_THIRD, 0.5f }, { ONE_THIRD, 1.0f },           // Bottom - Back Left Triangle
+        { 0.0f, 0.5f }, { 0.0f, 1.0f }, { ONE_THIRD, 1.0f },                // Bottom - Front Right Triangle
+        { ONE_THIRD, 0.5f }, { ONE_THIRD, 0.0f }, { TWO_THIRDS, 0.0f },     // Front - Bottom Left Triangle
+        { ONE_THIRD, 0.5f }, { TWO_THIRDS, 0.5f }, { TWO_THIRDS, 0.0f },    // Front - Top Right Triangle
+        { 0.0f, 0.5f }, { 0.0f, 0.0f }, { ONE_THIRD, 0.0f },                // Left - Bottom Back Triangle
+        { 0.0f, 0.5f }, { ONE_THIRD, 0.5f }, { ONE_THIRD, 0.0f },           // Left - Top Front Triangle
+        { TWO_THIRDS, 1.0f }, { ONE_THIRD, 1.0f }, { ONE_THIRD, 0.5f },     // Back - Bottom Right Triangle
+        { TWO_THIRDS, 1.0f }, { TWO_THIRDS, 0.5f }, { ONE_THIRD, 0.5f },    // Back - Top Left Triangle
+        { TWO_THIRDS, 0.5f }, { TWO_THIRDS, 0.0f }, { 1.0f, 0.0f },         // Right - Bottom Front Triangle
+        { TWO_THIRDS, 0.5f }, { 1.0f, 0.5f }, { 1.0f, 0.0f },               // Right - Top Back Triangle
+        { TWO_THIRDS, 0.5f }, { 1.0f, 0.5f }, { 1.0f, 1.0f },               // Top - Front Left Triangle
+        { TWO_THIRDS, 0.5f }, { TWO_THIRDS, 1.0f }, { 1.0f, 1.0f },         // Top - Back Right Triangle
+    }});
+
+
+    // ###########
+    // # Pyramid #
+    // ###########
+
+
+    // Corners shared by every face, for modes without UVs
+    constexpr BakedShape<5, 18> PYRAMID_CORNERS = {
+        {{
+            // Base Corners
+            { -0.5f, -0.5f,  0.5f },   // Left, Bottom, Front
+            { -0.5f, -0.5f, -0.5f },   // Left, Bottom, Back
+            {  0.5f, -0.5f, -0.5f },   // Right, Bottom, Back
+            {  0.5f, -0.5f,  0.5f },   // Right, Bottom, Front
+
+            // Peak
+            {  0.0f,  0.5f,  0.0f },   // Center, Top, Center
+        }},
+        {
+            0, 1, 2,    // Triangle 1 - Base: Left, Back
+            2, 3, 0,    // Triangle 2 - Base: Right, Front
+            0, 4, 3,    // Triangle 3 - Side: Front
+            1, 4, 0,    // Triangle 4 - Side: Left
+            2, 4, 1,    // Triangle 5 - Side: Back
+            3, 4, 2,    // Triangle 6 - Side: Right
+        }
+    };
+
+    // A vertex per triangle corner, each side maps the whole texture with the peak at the top center
+    constexpr BakedShape<18, 18> PYRAMID_FACES = unweld(PYRAMID_CORNERS.vertices, std::array<GLuint, 18>{
+        0, 1, 2,    // Base Back Left Triangle
+        0, 3, 2,    // Base Front Right Triangle
+        0, 4, 3,    // Front Side
+        1, 4, 0,    // Left Side
+        1, 4, 2,    // Back Side
+        2, 4, 3,    // Right Side
+    }, std::array<UVs, 18>{{
+        { 0.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f },     // Base Back Left Triangle
+        { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f },     // Base Front Right Triangle
+        { 0.0f, 0.0f }, { 0.5f, 1.0f }, { 1.0f, 0.0f },     // Front Side
+        { 1.0f, 0.0f }, { 0.5f, 1.0f }, { 0.0f, 0.0f },     // Left Side - Flipped texture horazontally for nice wrap between sides
+        { 1.0f, 0.0f }, { 0.5f, 1.0f }, { 0.0f, 0.0f },     // Back Side - Flipped texture horazontally for nice wrap between sides
+        { 0.0f, 0.0f }, { 0.5f, 1.0f }, { 1.0f, 0.0f },     // Right Side
+    }});
+
+
+    // #########
+    // # Plane #
+    // #########
+
+
+    // Corners shared by both triangles, for modes without UVs
+    constexpr BakedShape<4, 6> PLANE_CORNERS = {
+        {{
+            { -0.5f, 0.0f,  0.5f },    // Left, Front
+            { -0.5f, 0.0f, -0.5f },    // Left, Back
+            {  0.5f, 0.0f, -0.5f },    // Right, Back
+            {  0.5f, 0.0f,  0.5f },    // Right, Front
+        }},
+        {
+            0, 1, 2,    // Triangle 1 - Center: Left, Back
+            2, 3, 0,    // Triangle 2 - Center: Right, Front
+        }
+    };
+
+    // A vertex per triangle corner, the whole texture across the plane
+    constexpr BakedShape<6, 6> PLANE_FACES = unweld(PLANE_CORNERS.vertices, PLANE_CORNERS.elements, std::array<UVs, 6>{{
+        { 0.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f },     // Back Left Triangle
+        { 1.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f },     // Front Right Triangle
+    }});
+}
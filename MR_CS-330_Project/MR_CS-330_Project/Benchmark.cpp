@@ -0,0 +1,253 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "GeometryCache.h"
+#include "MeshBuildArena.h"
+#include "MeshOptimizer.h"
+#include "VertexTransform.h"
+#include "SodaCanMesh.h"
+#include "PS5ControllerMesh.h"
+#include "HeadsetMesh.h"
+#include "BackScratcherMesh.h"
+#include "SphereMesh.h"
+#include "TorusMesh.h"
+#include "FrustumMesh.h"
+#include "CylinderMesh.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Unnamed namespace
+namespace
+{
+    /**
+     * Time building a composite mesh from the heap, then the build arena, then the build arena and the geometry cache,
+     * and print the averages.
+     * A build constructs the mesh and generates its vertices, the same as the scene setup before generating the VAO.
+     */
+    template<typename CreateMesh>
+    void timeBuilds(const char* name, unsigned int iterations, CreateMesh createMesh)
+    {
+        MeshBuildArena& arena = MeshBuildArena::getInstance();
+        GeometryCache& geometryCache = GeometryCache::getInstance();
+        bool wasArenaEnabled = arena.getEnabled();
+        bool wasCacheEnabled = geometryCache.getEnabled();
+
+        for (int run = 0; run < 3; ++run) {
+            bool useArena = run >= 1;
+            bool useCache = run >= 2;
+            arena.setEnabled(useArena);
+            geometryCache.setEnabled(useCache);
+
+            // Warm up, so the arena has grown to fit a build and the cache holds its parts before measuring
+            auto warmUp = createMesh();
+            warmUp.generateVertices();
+
+            AllocationSnapshot startAllocations = AllocationCounter::getSnapshot();
+            auto startTime = std::chrono::steady_clock::now();
+            for (unsigned int i = 0; i < iterations; ++i) {
+                auto mesh = createMesh();
+                mesh.generateVertices();
+            }
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+            AllocationSnapshot allocations = AllocationCounter::getAllocationsSince(startAllocations);
+
+            std::cout << "INFO: Benchmark: " << name << (useCache ? " (arena + cache): " : useArena ? " (arena): " : " (heap):  ")
+                << elapsed.count() / iterations << " ms per build";
+            if (AllocationCounter::isEnabled()) {
+                std::cout << ", " << allocations.allocations / iterations << " allocations ("
+                    << allocations.bytes / iterations << " bytes) per build";
+            }
+            std::cout << std::endl;
+        }
+
+        arena.setEnabled(wasArenaEnabled);
+        geometryCache.setEnabled(wasCacheEnabled);
+    }
+
+    /**
+     * Time generating a mesh with 1, 2, 4, ... MAX_GENERATION_THREADS threads and print the averages.
+     * The buffers of every thread count are compared to the buffers generated with 1 thread.
+     * The geometry cache is disabled, so every generation runs the generator instead of copying the first one.
+     */
+    template<typename MeshType>
+    void timeGeneration(const char* name, unsigned int iterations, MeshType mesh)
+    {
+        GeometryCache& geometryCache = GeometryCache::getInstance();
+        bool wasCacheEnabled = geometryCache.getEnabled();
+        geometryCache.setEnabled(false);
+
+        std::vector<GLfloat> singleThreadVertices;
+        std::vector<GLuint> singleThreadElements;
+        double singleThreadTime = 0.0;
+
+        for (unsigned int threads = 1; threads <= Benchmark::MAX_GENERATION_THREADS; threads *= 2) {
+            mesh.setGenerationThreadCount(threads);
+
+            double totalTime = 0.0;
+            bool identical = true;
+            for (unsigned int i = 0; i < iterations; ++i) {
+                MeshType generated = mesh;
+                auto startTime = std::chrono::steady_clock::now();
+                generated.generateVertices();
+                std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+                totalTime += elapsed.count();
+
+                std::span<const GLfloat> vertices = generated.getVertexBuffer();
+                std::span<const GLuint> elements = generated.getElementBuffer();
+                if (threads == 1 && i == 0) {
+                    singleThreadVertices.assign(vertices.begin(), vertices.end());
+                    singleThreadElements.assign(elements.begin(), elements.end());
+                }
+                else {
+                    identical &= std::ranges::equal(vertices, singleThreadVertices) && std::ranges::equal(elements, singleThreadElements);
+                }
+            }
+
+            double time = totalTime / iterations;
+            if (threads == 1) {
+                singleThreadTime = time;
+            }
+            std::cout << "INFO: Benchmark: " << name << " " << threads << " threads: " << time << " ms per generation, "
+                << singleThreadTime / time << "x" << (identical ? "" : " (buffers differ from 1 thread)") << std::endl;
+        }
+
+        geometryCache.setEnabled(wasCacheEnabled);
+    }
+
+    /**
+     * Weld a mesh's vertices the same as generating the VAO does, then join its triangles into strips and print the sizes.
+     */
+    template<typename MeshType>
+    void measureStrips(const char* name, MeshType mesh)
+    {
+        mesh.generateVertices();
+        std::span<const GLfloat> vertices = mesh.getVertexBuffer();
+        std::span<const GLuint> elements = mesh.getElementBuffer();
+        std::pmr::vector<GLfloat> weldedVertices(vertices.begin(), vertices.end());
+        std::pmr::vector<GLuint> triangles(elements.begin(), elements.end());
+        GLuint floatsPerAllAttributes = mesh.getFloatsPerVertex() + mesh.getFloatsPerColor() + mesh.getFloatsPerNormal() + mesh.getFloatsPerUV();
+        MeshOptimizer::weldVertices(weldedVertices, triangles, floatsPerAllAttributes);
+
+        std::pmr::vector<GLuint> strips;
+        auto startTime = std::chrono::steady_clock::now();
+        MeshOptimizer::stripifyTriangles(triangles, strips);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+
+        std::cout << "INFO: Benchmark: " << name << " triangle lists " << triangles.size() << " elements, strips " << strips.size()
+            << " elements (" << 100.0 * strips.size() / triangles.size() << "%) in " << elapsed.count() << " ms" << std::endl;
+    }
+}
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// #################
+// # Other methods #
+// #################
+
+
+void Benchmark::runCompositeBuilds(unsigned int iterations)
+{
+    if (iterations == 0) {
+        return;
+    }
+
+    // Same detail as the scene
+    const int SECTOR_COUNT = 50;
+
+    std::cout << "INFO: Benchmark: Vertex transform path " << VertexTransform::getPathName(VertexTransform::getPath()) << std::endl;
+    if (!AllocationCounter::isEnabled()) {
+        std::cout << "INFO: Benchmark: Allocations are only counted in Debug builds" << std::endl;
+    }
+
+    timeBuilds("SodaCanMesh", iterations, [&]() {
+        return SodaCanMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 3.31f, 12.4f, SECTOR_COUNT);
+    });
+    timeBuilds("PS5ControllerMesh", iterations, [&]() {
+        return PS5ControllerMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, SECTOR_COUNT);
+    });
+    timeBuilds("HeadsetMesh", iterations, [&]() {
+        return HeadsetMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, SECTOR_COUNT);
+    });
+    timeBuilds("BackScratcherMesh", iterations, [&]() {
+        return BackScratcherMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, SECTOR_COUNT);
+    });
+
+    std::cout << "INFO: Benchmark: Arena capacity " << MeshBuildArena::getInstance().getCapacity() << " bytes" << std::endl;
+
+    GeometryCacheStats cacheStats = GeometryCache::getInstance().getStats();
+    std::cout << "INFO: Benchmark: Geometry cache " << cacheStats.hits << " hits, " << cacheStats.misses << " misses, "
+        << cacheStats.entries << " geometries (" << cacheStats.bytes << " bytes)" << std::endl;
+}
+
+void Benchmark::runParallelGeneration(unsigned int iterations)
+{
+    if (iterations == 0) {
+        return;
+    }
+
+    // About 2 million vertices each, the detail of the close-up renders
+    const int SLICES = 2048;
+    const int STACKS = 1024;
+    const int SECTOR_COUNT = 131072;
+
+    std::cout << "INFO: Benchmark: Thread pool of " << ThreadPool::getInstance().getThreadCount() << " threads" << std::endl;
+
+    timeGeneration("SphereMesh", iterations, SphereMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 1.0f, SLICES, STACKS));
+    timeGeneration("TorusMesh", iterations, TorusMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 1.0f, 0.5f, SLICES, STACKS));
+    timeGeneration("FrustumMesh", iterations, FrustumMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 0.5f, 1.0f, 1.0f, SECTOR_COUNT));
+}
+
+void Benchmark::runCylinderGeneration(unsigned int iterations)
+{
+    if (iterations == 0) {
+        return;
+    }
+
+    // Same detail as the composite mesh parts
+    const int SECTOR_COUNT = 50;
+
+    GeometryCache& geometryCache = GeometryCache::getInstance();
+    bool wasCacheEnabled = geometryCache.getEnabled();
+
+    for (bool useCache : { false, true }) {
+        geometryCache.setEnabled(useCache);
+
+        // Warm up, so the cache holds the cylinder before measuring
+        CylinderMesh warmUp(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 1.0f, 2.0f, SECTOR_COUNT);
+        warmUp.generateVertices();
+
+        auto startTime = std::chrono::steady_clock::now();
+        for (unsigned int i = 0; i < iterations; ++i) {
+            CylinderMesh cylinder(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 1.0f, 2.0f, SECTOR_COUNT);
+            cylinder.generateVertices();
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+        std::cout << "INFO: Benchmark: CylinderMesh" << (useCache ? " (cache): " : " (generated): ")
+            << iterations / elapsed.count() << " cylinders per second" << std::endl;
+    }
+
+    geometryCache.setEnabled(wasCacheEnabled);
+}
+
+void Benchmark::runTriangleStrips()
+{
+    // Same detail as the scene
+    const int SECTOR_COUNT = 50;
+
+    measureStrips("SphereMesh", SphereMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 1.0f, SECTOR_COUNT, SECTOR_COUNT / 2));
+    measureStrips("TorusMesh", TorusMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 1.0f, 0.5f, SECTOR_COUNT, SECTOR_COUNT));
+    measureStrips("FrustumMesh", FrustumMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 0.5f, 1.0f, 1.0f, SECTOR_COUNT));
+    measureStrips("SodaCanMesh", SodaCanMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, 3.31f, 12.4f, SECTOR_COUNT));
+    measureStrips("PS5ControllerMesh", PS5ControllerMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, SECTOR_COUNT));
+    measureStrips("HeadsetMesh", HeadsetMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, SECTOR_COUNT));
+    measureStrips("BackScratcherMesh", BackScratcherMesh(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, -1, SECTOR_COUNT));
+}
@@ -0,0 +1,61 @@
+// Benchmark.h
+#pragma once
+
+/**
+ * Class representing the timing runs started with the --benchmark command line argument, run instead of opening a window.
+ */
+class Benchmark {
+public:
+    // Prevent construction, the benchmarks hold no state
+    Benchmark() = delete;
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Build each composite mesh of the scene repeatedly, with its child meshes allocated from the heap, from the
+     * build arena, and from the build arena with their geometry shared by the GeometryCache, and print the time and
+     * heap allocations per build.
+     * Allocations are only counted when COUNT_ALLOCATIONS is defined (Debug builds).
+     *
+     * @param iterations The number of builds to average over.
+     */
+    static void runCompositeBuilds(unsigned int iterations = DEFAULT_ITERATIONS);
+
+    /**
+     * Generate very high detail spheres, tori, and frusta with 1 to MAX_GENERATION_THREADS threads and print the
+     * time and speedup over 1 thread, checking that every thread count generates the same buffers.
+     *
+     * @param iterations The number of generations to average over.
+     */
+    static void runParallelGeneration(unsigned int iterations = DEFAULT_GENERATION_ITERATIONS);
+
+    /**
+     * Generate cylinders with the detail of the composite mesh parts repeatedly, generating every one and then
+     * sharing them through the GeometryCache, and print the cylinders generated per second.
+     *
+     * @param iterations The number of cylinders to generate per measurement.
+     */
+    static void runCylinderGeneration(unsigned int iterations = DEFAULT_CYLINDER_ITERATIONS);
+
+    /**
+     * Join the welded triangles of spheres, tori, frusta, and the composite meshes of the scene into triangle strips
+     * and print the elements of the lists and the strips, and the time taken to build the strips.
+     */
+    static void runTriangleStrips();
+
+
+    // #############
+    // # Variables #
+    // #############
+
+
+    // Class constants
+    static constexpr unsigned int DEFAULT_ITERATIONS = 100;    // Builds averaged per measurement
+    static constexpr unsigned int DEFAULT_GENERATION_ITERATIONS = 5;   // High detail generations averaged per measurement
+    static constexpr unsigned int MAX_GENERATION_THREADS = 32;  // Most threads the generation is timed with
+    static constexpr unsigned int DEFAULT_CYLINDER_ITERATIONS = 10000;  // Cylinders generated per measurement
+};
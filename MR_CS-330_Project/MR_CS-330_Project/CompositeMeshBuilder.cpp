@@ -0,0 +1,81 @@
+#include "CompositeMeshBuilder.h"
+#include "Mesh.h"
+#include "VertexTransform.h"
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// ################
+// # Constructors #
+// ################
+
+
+CompositeMeshBuilder::CompositeMeshBuilder(VertexMode vertexMode)
+    : vertexMode(vertexMode), floatsPerAllAttributes(0), parts(MeshBuildArena::getInstance().getResource())
+{
+    visitVertexFormat(vertexMode, [this](auto vertex) {
+        floatsPerAllAttributes = decltype(vertex)::FLOATS_PER_VERTEX;
+    });
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+void CompositeMeshBuilder::addPart(const Mesh& part)
+{
+    parts.push_back({ &part, glm::mat4(1.0f) });
+}
+
+void CompositeMeshBuilder::stackPartTransform(Mesh& part)
+{
+    for (auto it = parts.rbegin(); it != parts.rend(); ++it) {
+        if (it->mesh == &part) {
+            it->stackedTransform = part.getModel() * it->stackedTransform;
+            break;
+        }
+    }
+
+    part.setScale(Mesh::DEFAULT_SCALE_VEC3);
+    part.setRotation(Mesh::DEFAULT_ROTATION_DEGREES_VEC3);
+    part.setTranslation(Mesh::DEFAULT_TRANSLATION_VEC3);
+}
+
+void CompositeMeshBuilder::build(std::pmr::vector<GLfloat>& vertexBuffer, std::pmr::vector<GLuint>& elementBuffer, const glm::mat4& transform) const
+{
+    // Size the buffers once, every part writes its own slice
+    size_t vertexValueOffset = vertexBuffer.size();
+    size_t elementOffset = elementBuffer.size();
+    size_t vertexValueCount = vertexValueOffset;
+    size_t elementCount = elementOffset;
+    for (const Part& part : parts) {
+        vertexValueCount += part.mesh->getVertexBuffer().size();
+        elementCount += part.mesh->getElementBuffer().size();
+    }
+    vertexBuffer.resize(vertexValueCount);
+    elementBuffer.resize(elementCount);
+
+    for (const Part& part : parts) {
+        std::span<const GLfloat> partVertices = part.mesh->getVertexBuffer();
+        std::span<const GLuint> partElements = part.mesh->getElementBuffer();
+
+        // The part transforms and the composite transform are combined, so each vertex is transformed once
+        glm::mat4 partTransform = transform * part.mesh->getModel() * part.stackedTransform;
+        VertexTransform::transformVertices(partVertices, std::span<GLfloat>(vertexBuffer).subspan(vertexValueOffset, partVertices.size()), vertexMode, partTransform);
+
+        GLuint baseVertex = static_cast<GLuint>(vertexValueOffset / floatsPerAllAttributes);
+        for (size_t i = 0; i < partElements.size(); ++i) {
+            elementBuffer[elementOffset + i] = partElements[i] + baseVertex;
+        }
+
+        vertexValueOffset += partVertices.size();
+        elementOffset += partElements.size();
+    }
+}
@@ -0,0 +1,89 @@
+// CompositeMeshBuilder.h
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <memory_resource>
+#include <span>
+#include <vector>
+#include "MeshBuildArena.h"
+#include "VertexFormat.h"
+
+class Mesh;
+
+/**
+ * Class representing the build of a composite mesh from generated part meshes.
+ * Parts are generated untransformed and added, then build writes every part into its slice of the composite's
+ * buffers in one pass, with the part and composite transforms applied together and the elements offset.
+ * The builder opens a MeshBuildArena scope, so parts constructed after it allocate from the build arena;
+ * declare it before the parts.
+ */
+class CompositeMeshBuilder {
+public:
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * CompositeMeshBuilder constructor.
+     *
+     * @param vertexMode The vertex mode of the composite and all of its parts.
+     */
+    CompositeMeshBuilder(VertexMode vertexMode);
+
+    // Prevent copying and assignment
+    CompositeMeshBuilder(const CompositeMeshBuilder&) = delete;
+    void operator=(const CompositeMeshBuilder&) = delete;
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Add a generated part, its transform (the model matrix) is read when building.
+     *
+     * @param part The part, which must stay alive until build.
+     */
+    void addPart(const Mesh& part);
+
+    /**
+     * Fix the current transform of an added part and reset it to the default transform, so further transforms of
+     * the part are applied after it (the same as translateMeshPreVAO between transforms).
+     *
+     * @param part The added part.
+     */
+    void stackPartTransform(Mesh& part);
+
+    /**
+     * Append every part to the composite's buffers, in the order they were added.
+     * The buffers are resized once and each part's vertices are transformed straight into their slice.
+     *
+     * @param vertexBuffer The composite's vertex buffer.
+     * @param elementBuffer The composite's element buffer.
+     * @param transform The transform of the composite, applied after the part transforms.
+     */
+    void build(std::pmr::vector<GLfloat>& vertexBuffer, std::pmr::vector<GLuint>& elementBuffer, const glm::mat4& transform) const;
+
+private:
+    /**
+     * Struct representing an added part.
+     */
+    struct Part {
+        const Mesh* mesh;               // The generated part
+        glm::mat4 stackedTransform;     // Transforms fixed before the current transform of the part
+    };
+
+
+    // #############
+    // # Variables #
+    // #############
+
+
+    MeshBuildArena::Scope buildScope;   // Keeps the build arena open for the parts
+    VertexMode vertexMode;              // Vertex mode of the composite and parts
+    GLuint floatsPerAllAttributes;      // Number of floats in each vertex
+    std::pmr::vector<Part> parts;       // Added parts, in order
+};
@@ -1,12 +1,13 @@
 // CylinderMesh.h
 #pragma once
 
-#include "Mesh.h"
+#include "FrustumMesh.h"
 
 /**
  * Class representing a CylinderMesh object with transformations.
+ * A cylinder is a frustum with matching top and bottom radii, generated directly into its own buffers.
  */
-class CylinderMesh : public Mesh {
+class CylinderMesh : public FrustumMesh {
 public:
     // ################
     // # Constructors #
@@ -41,25 +42,4 @@ public:
      * @param sectorCount The number of sectors around the cylinder (greater = more triangles and detail).
      */
     CylinderMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, GLuint shaderProgramId = -1, float radius = 1, float height = 1, int sectorCount = 100);
-
-
-    // #############################
-    // # Abstract method overrides #
-    // #############################
-
-
-    /**
-     * Generate the vertex and element buffer.
-     * Must be used before generateVAO().
-     */
-    void generateVertices() override;
-
-private:
-    // #############
-    // # Variables #
-    // #############
-
-    float radius;       // The radius of the Cylinder
-    float height;       // The height of the Cylinder from top to bottom (y-axis)
-    int sectorCount;    // The number of sectors around the cylinder (greater = more triangles and detail)
-};
\ No newline at end of file
+};
@@ -4,6 +4,8 @@
 
 #include "Mesh.h"
 
+class TrigTable;
+
 /**
  * Class representing a FrustumMesh object with transformations.
  */
@@ -59,6 +61,28 @@ public:
      */
     void generateVertices() override;
 
+protected:
+    // ############################
+    // # Virtual method overrides #
+    // ############################
+
+
+    /**
+     * Set the detail the vertices are generated with, each level halving the sectors around the Frustum.
+     *
+     * @param level The level of detail (0 = the detail the Frustum was created with).
+     * @return The angle between neighboring sectors at the level in radians.
+     */
+    float setDetailLevel(int level) override;
+
+    /**
+     * Get the parameters the procedural vertex shader builds the Frustum from, at the current detail level.
+     *
+     * @param geometry Reference to store the parameters in.
+     * @return True, a Frustum can always be pulled.
+     */
+    bool getProceduralGeometry(ProceduralGeometry& geometry) const override;
+
 private:
     // #################
     // # Other methods #
@@ -68,19 +92,23 @@ private:
     /**
      * Calculate the vertex based on the current sector.
      *
+     * @param sectorAngles The sines and cosines of the sector angles.
      * @param SectorIndex The index of the current sector.
+     * @param radius The radius of the circle the vertex is on.
      * @return The resulting vec3 of x, y, z values.
      */
-    const glm::vec3 calculateSectorVertex(int SectorIndex, float radius);
+    const glm::vec3 calculateSectorVertex(const TrigTable& sectorAngles, int SectorIndex, float radius);
 
 
     /**
-     * Calculate the vertex based on the current sector.
+     * Calculate the texture uv based on the current sector.
      *
+     * @param sectorAngles The sines and cosines of the sector angles.
      * @param SectorIndex The index of the current sector.
-     * @return The resulting vec3 of x, y, z values.
+     * @param topCircle True for the top circle, false for the bottom circle.
+     * @return The resulting vec2 of u, v values.
      */
-    const glm::vec2 calculateSectorUV(int SectorIndex, bool topCircle);
+    const glm::vec2 calculateSectorUV(const TrigTable& sectorAngles, int SectorIndex, bool topCircle);
 
 
     // #############
@@ -91,4 +119,5 @@ private:
     float bottomRadius; // The radius of the bottom of the Frustum
     float height;       // The height of the Frustum from top to bottom (y-axis)
     int sectorCount;    // The number of sectors around the Frustum (greater = more triangles and detail OR more sides)
+    int fullSectorCount; // The number of sectors the Frustum was created with (full detail)
 };
\ No newline at end of file
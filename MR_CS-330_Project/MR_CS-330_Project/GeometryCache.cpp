@@ -0,0 +1,159 @@
+#include "GeometryCache.h"
+#include <iostream>
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// ################
+// # Constructors #
+// ################
+
+
+GeometryKey::GeometryKey(const char* type) : hash(14695981039346656037ull), parameterByteCount(0), parameterBytes()
+{
+    addBytes(reinterpret_cast<const unsigned char*>(type), std::strlen(type) + 1);
+}
+
+
+// ######################
+// # Singleton Instance #
+// ######################
+
+
+GeometryCache& GeometryCache::getInstance()
+{
+    static GeometryCache instance;
+    return instance;
+}
+
+
+// ##################
+// # Getter methods #
+// ##################
+
+
+const uint64_t GeometryKey::getHash() const
+{
+    return hash;
+}
+
+const GeometryCacheStats GeometryCache::getStats()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return stats;
+}
+
+const bool GeometryCache::getEnabled() const
+{
+    return enabled;
+}
+
+
+// ##################
+// # Setter methods #
+// ##################
+
+
+void GeometryCache::setEnabled(bool enabled)
+{
+    this->enabled = enabled;
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+bool GeometryKey::operator==(const GeometryKey& other) const
+{
+    return hash == other.hash && parameterByteCount == other.parameterByteCount
+        && std::memcmp(parameterBytes.data(), other.parameterBytes.data(), parameterByteCount) == 0;
+}
+
+std::shared_ptr<const CachedGeometry> GeometryCache::find(const GeometryKey& key)
+{
+    if (!enabled) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = geometries.find(key);
+    if (it == geometries.end()) {
+        ++stats.misses;
+        return nullptr;
+    }
+    ++stats.hits;
+    return it->second;
+}
+
+std::shared_ptr<const CachedGeometry> GeometryCache::insert(const GeometryKey& key, std::span<const GLfloat> vertexBuffer, std::span<const GLuint> elementBuffer)
+{
+    // Copy outside the lock, another thread may have stored the same geometry meanwhile
+    auto geometry = std::make_shared<CachedGeometry>();
+    geometry->vertexBuffer.assign(vertexBuffer.begin(), vertexBuffer.end());
+    geometry->elementBuffer.assign(elementBuffer.begin(), elementBuffer.end());
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto [it, inserted] = geometries.try_emplace(key, std::move(geometry));
+    if (inserted) {
+        stats.entries = geometries.size();
+        stats.bytes += vertexBuffer.size_bytes() + elementBuffer.size_bytes();
+    }
+    return it->second;
+}
+
+void GeometryCache::clear()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    geometries.clear();
+    stats = GeometryCacheStats();
+}
+
+
+// ###################
+// #                 #
+// # Private methods #
+// #                 #
+// ###################
+
+
+// ################
+// # Constructors #
+// ################
+
+
+GeometryCache::GeometryCache() : enabled(true)
+{
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+void GeometryKey::addBytes(const unsigned char* bytes, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+
+    // Parameters past the capacity are still hashed, keys that long only compare by hash
+    if (parameterByteCount + count > MAX_PARAMETER_BYTES) {
+        std::cout << "WARNING: GeometryKey: Parameters exceed " << MAX_PARAMETER_BYTES << " bytes" << std::endl;
+        count = MAX_PARAMETER_BYTES - parameterByteCount;
+    }
+    std::memcpy(parameterBytes.data() + parameterByteCount, bytes, count);
+    parameterByteCount += count;
+}
+
+size_t GeometryCache::KeyHash::operator()(const GeometryKey& key) const
+{
+    return static_cast<size_t>(key.getHash());
+}
@@ -0,0 +1,232 @@
+// GeometryCache.h
+#pragma once
+
+#include <GL/glew.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Class representing the parameters a primitive mesh was generated from, hashed with 64 bit FNV-1a.
+ * Keys compare their parameter bytes as well as the hash, so a hash collision can not return the wrong geometry.
+ */
+class GeometryKey {
+public:
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * GeometryKey constructor.
+     *
+     * @param type The name of the mesh type, so different types with the same parameters do not share geometry.
+     */
+    GeometryKey(const char* type);
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the hash of the parameters.
+     *
+     * @return The 64 bit FNV-1a hash.
+     */
+    const uint64_t getHash() const;
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Add a generation parameter to the key.
+     *
+     * @param value The parameter, a trivially copyable value.
+     * @return The key, so parameters can be chained.
+     */
+    template <typename T>
+    GeometryKey& add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Geometry key parameters must be trivially copyable");
+        addBytes(reinterpret_cast<const unsigned char*>(&value), sizeof(T));
+        return *this;
+    }
+
+    bool operator==(const GeometryKey& other) const;
+
+
+    // #############
+    // # Variables #
+    // #############
+
+
+    // Class constants
+    static constexpr size_t MAX_PARAMETER_BYTES = 128;  // Most bytes of parameters a key holds
+
+private:
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Hash and store the bytes of a parameter.
+     *
+     * @param bytes The bytes of the parameter.
+     * @param count The number of bytes.
+     */
+    void addBytes(const unsigned char* bytes, size_t count);
+
+
+    // #############
+    // # Variables #
+    // #############
+
+    uint64_t hash;                                                  // FNV-1a hash of the type and parameters
+    size_t parameterByteCount;                                      // Number of bytes of parameters stored
+    std::array<unsigned char, MAX_PARAMETER_BYTES> parameterBytes;  // The type and parameters, compared on lookup
+};
+
+/**
+ * Struct representing the shared, immutable buffers of a generated primitive.
+ */
+struct CachedGeometry {
+    std::vector<GLfloat> vertexBuffer;  // Interleaved vertices in the vertex mode of the key
+    std::vector<GLuint> elementBuffer;  // Elements of the triangles
+};
+
+/**
+ * Struct representing how often the cache had the geometry a mesh asked for.
+ */
+struct GeometryCacheStats {
+    int hits = 0;                       // Lookups that found generated geometry
+    int misses = 0;                     // Lookups that had to generate the geometry
+    size_t entries = 0;                 // Number of distinct geometries held
+    size_t bytes = 0;                   // Bytes of vertices and elements held
+};
+
+/**
+ * Class representing the process-wide cache of generated primitive geometry, keyed by the generation parameters.
+ * Meshes generated with the same parameters share one copy of the buffers, which the cache never changes.
+ * Lookups are guarded by a lock, so meshes on any thread can share geometry.
+ */
+class GeometryCache {
+public:
+    // ######################
+    // # Singleton Instance #
+    // ######################
+
+
+    /**
+     * Get the Geometry Cache Singleton Instance
+     */
+    static GeometryCache& getInstance();
+
+    // Prevent copying and assignment
+    GeometryCache(const GeometryCache&) = delete;
+    void operator=(const GeometryCache&) = delete;
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the hits and misses of the lookups so far and the size of the cache.
+     *
+     * @return The cache stats.
+     */
+    const GeometryCacheStats getStats();
+
+    /**
+     * Check if meshes look up and store their geometry in the cache.
+     *
+     * @return True if the cache is enabled.
+     */
+    const bool getEnabled() const;
+
+
+    // ##################
+    // # Setter methods #
+    // ##################
+
+
+    /**
+     * Set if meshes look up and store their geometry in the cache.
+     * Geometry already in the cache is kept.
+     *
+     * @param enabled True to share geometry, false to generate every mesh.
+     */
+    void setEnabled(bool enabled);
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Find the geometry generated with a key, counting a hit or a miss.
+     *
+     * @param key The generation parameters.
+     * @return The shared geometry, or null if none was stored with the key or the cache is disabled.
+     */
+    std::shared_ptr<const CachedGeometry> find(const GeometryKey& key);
+
+    /**
+     * Store a copy of generated geometry for a key, unless geometry is already stored with it.
+     *
+     * @param key The generation parameters.
+     * @param vertexBuffer The generated vertices.
+     * @param elementBuffer The generated elements.
+     * @return The shared geometry stored with the key.
+     */
+    std::shared_ptr<const CachedGeometry> insert(const GeometryKey& key, std::span<const GLfloat> vertexBuffer, std::span<const GLuint> elementBuffer);
+
+    /**
+     * Release all geometry and reset the stats. Meshes still holding shared geometry keep it alive.
+     */
+    void clear();
+
+private:
+    /**
+     * Struct hashing a key for the map, with the hash it already computed.
+     */
+    struct KeyHash {
+        size_t operator()(const GeometryKey& key) const;
+    };
+
+
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * GeometryCache constructor.
+     */
+    GeometryCache();
+
+
+    // #############
+    // # Variables #
+    // #############
+
+    std::unordered_map<GeometryKey, std::shared_ptr<const CachedGeometry>, KeyHash> geometries; // Generated geometry by key
+    GeometryCacheStats stats;           // Lookups so far and the size of the cache
+    std::mutex cacheMutex;              // Guards the geometries and stats
+    std::atomic<bool> enabled;          // Meshes use the cache
+};
@@ -1,4 +1,5 @@
 #include "HeadsetMesh.h"
+#include "CompositeMeshBuilder.h"
 #include "PyramidMesh.h"
 #include "CubeMesh.h"
 #include "CubeLightMesh.h"
@@ -22,12 +23,12 @@
 
 
 HeadsetMesh::HeadsetMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, glm::vec3 scale, glm::vec3 rotationDegrees, glm::vec3 translation, RotationOrder rotationOrder, GLuint shaderProgramId, int sectorCount)
-    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), sectorCount(sectorCount)
+    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), sectorCount(sectorCount), fullSectorCount(sectorCount)
 {
 }
 
 HeadsetMesh::HeadsetMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, GLuint shaderProgramId, int sectorCount)
-    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), sectorCount(sectorCount)
+    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), sectorCount(sectorCount), fullSectorCount(sectorCount)
 {
 }
 
@@ -59,7 +60,8 @@ void HeadsetMesh::generateVertices()
     float innerEarpieceRadius = 4.15f;
     float innerEarpieceThickness = 2.5f;
 
-    std::vector<Mesh*> meshes;
+    // Parts are generated untransformed, then built into the buffers with their transforms in one pass
+    CompositeMeshBuilder builder(vertexMode);
 
     // Headband Center
     CubeMesh upperHeadbandCenter(vertexMode, UnitOfMeasure::CENTIMETER, -1, upperHeadbandSegmentWidth, frameDepth, frameThickness);
@@ -69,8 +71,7 @@ void HeadsetMesh::generateVertices()
     upperHeadbandCenter.translateMesh(0.0f, 0.0f, -10.75f + (frameThickness /2.0f));
     upperHeadbandCenter.setColor(color);
     upperHeadbandCenter.generateVertices();
-    upperHeadbandCenter.translateMeshPreVAO();
-    meshes.push_back(&upperHeadbandCenter);
+    builder.addPart(upperHeadbandCenter);
 
     CylinderMesh upperHeadbandCenterFoam(vertexMode, UnitOfMeasure::CENTIMETER, -1, upperHeadbandFoamRadius, upperHeadbandSegmentWidth, sectorCount);
     upperHeadbandCenterFoam.setTextureUClamp(glm::vec2(0.0f, 1.0f / 7.0f));
@@ -79,10 +80,9 @@ void HeadsetMesh::generateVertices()
     upperHeadbandCenterFoam.rotateMesh(0.0f, 0.0f, 90.0f);
     upperHeadbandCenterFoam.setColor(color);
     upperHeadbandCenterFoam.generateVertices();
-    upperHeadbandCenterFoam.translateMeshPreVAO();
-    upperHeadbandCenterFoam.translateMesh(0.0f, 0.0f, -10.75f + (frameThickness / 2.0f));    upperHeadbandCenterFoam.translateMeshPreVAO();
-    upperHeadbandCenterFoam.translateMeshPreVAO();
-    meshes.push_back(&upperHeadbandCenterFoam);
+    builder.addPart(upperHeadbandCenterFoam);
+    builder.stackPartTransform(upperHeadbandCenterFoam);
+    upperHeadbandCenterFoam.translateMesh(0.0f, 0.0f, -10.75f + (frameThickness / 2.0f));
 
     // Headband Left
     CubeMesh upperHeadbandLeft(vertexMode, UnitOfMeasure::CENTIMETER, -1, upperHeadbandSegmentWidth, frameDepth, frameThickness);
@@ -92,8 +92,7 @@ void HeadsetMesh::generateVertices()
     upperHeadbandLeft.translateMesh(-(upperHeadbandSegmentWidth - 0.5f), 0.0f, -9.71f + (frameThickness / 2.0f));
     upperHeadbandLeft.setColor(color);
     upperHeadbandLeft.generateVertices();
-    upperHeadbandLeft.translateMeshPreVAO();
-    meshes.push_back(&upperHeadbandLeft);
+    builder.addPart(upperHeadbandLeft);
 
     CylinderMesh upperHeadbandLeftFoam(vertexMode, UnitOfMeasure::CENTIMETER, -1, upperHeadbandFoamRadius, upperHeadbandSegmentWidth, sectorCount);
     upperHeadbandLeftFoam.setTextureUClamp(glm::vec2(0.0f, 1.0f / 7.0f));
@@ -102,11 +101,10 @@ void HeadsetMesh::generateVertices()
     upperHeadbandLeftFoam.rotateMesh(0.0f, 0.0f, 90.0f);
     upperHeadbandLeftFoam.setColor(color);
     upperHeadbandLeftFoam.generateVertices();
-    upperHeadbandLeftFoam.translateMeshPreVAO();
+    builder.addPart(upperHeadbandLeftFoam);
+    builder.stackPartTransform(upperHeadbandLeftFoam);
     upperHeadbandLeftFoam.rotateMesh(0.0f, 27.0f, 0.0f);
     upperHeadbandLeftFoam.translateMesh(-(upperHeadbandSegmentWidth - 0.5f), 0.0f, -9.71f + (frameThickness / 2.0f));
-    upperHeadbandLeftFoam.translateMeshPreVAO();
-    meshes.push_back(&upperHeadbandLeftFoam);
 
     CubeMesh lowerHeadbandLeft(vertexMode, UnitOfMeasure::CENTIMETER, -1, lowerHeadbandSegmentWidth, frameDepth, frameThickness);
     lowerHeadbandLeft.setTextureUClamp(glm::vec2(4.0f / 7.0f, 1.0f));
@@ -115,8 +113,7 @@ void HeadsetMesh::generateVertices()
     lowerHeadbandLeft.translateMesh(-(upperHeadbandSegmentWidth + 3.58f), 0.0f, -5.86f + (frameThickness / 2.0f));
     lowerHeadbandLeft.setColor(color);
     lowerHeadbandLeft.generateVertices();
-    lowerHeadbandLeft.translateMeshPreVAO();
-    meshes.push_back(&lowerHeadbandLeft);
+    builder.addPart(lowerHeadbandLeft);
 
     // Headband Right
     CubeMesh upperHeadbandRight(vertexMode, UnitOfMeasure::CENTIMETER, -1, upperHeadbandSegmentWidth, frameDepth, frameThickness);
@@ -126,8 +123,7 @@ void HeadsetMesh::generateVertices()
     upperHeadbandRight.translateMesh((upperHeadbandSegmentWidth - 0.5f), 0.0f, -9.71f + (frameThickness / 2.0f));
     upperHeadbandRight.setColor(color);
     upperHeadbandRight.generateVertices();
-    upperHeadbandRight.translateMeshPreVAO();
-    meshes.push_back(&upperHeadbandRight);
+    builder.addPart(upperHeadbandRight);
 
     CylinderMesh upperHeadbandRightFoam(vertexMode, UnitOfMeasure::CENTIMETER, -1, upperHeadbandFoamRadius, upperHeadbandSegmentWidth, sectorCount);
     upperHeadbandRightFoam.setTextureUClamp(glm::vec2(0.0f, 1.0f / 7.0f));
@@ -136,11 +132,10 @@ void HeadsetMesh::generateVertices()
     upperHeadbandRightFoam.rotateMesh(0.0f, 0.0f, 90.0f);
     upperHeadbandRightFoam.setColor(color);
     upperHeadbandRightFoam.generateVertices();
-    upperHeadbandRightFoam.translateMeshPreVAO();
+    builder.addPart(upperHeadbandRightFoam);
+    builder.stackPartTransform(upperHeadbandRightFoam);
     upperHeadbandRightFoam.rotateMesh(0.0f, -27.0f, 0.0f);
     upperHeadbandRightFoam.translateMesh((upperHeadbandSegmentWidth - 0.5f), 0.0f, -9.71f + (frameThickness / 2.0f));
-    upperHeadbandRightFoam.translateMeshPreVAO();
-    meshes.push_back(&upperHeadbandRightFoam);
 
     CubeMesh lowerHeadbandRight(vertexMode, UnitOfMeasure::CENTIMETER, -1, lowerHeadbandSegmentWidth, frameDepth, frameThickness);
     lowerHeadbandRight.setTextureUClamp(glm::vec2(0.0f, 3.0f / 7.0f));
@@ -149,8 +144,7 @@ void HeadsetMesh::generateVertices()
     lowerHeadbandRight.translateMesh((upperHeadbandSegmentWidth + 3.58f), 0.0f, -5.86f + (frameThickness / 2.0f));
     lowerHeadbandRight.setColor(color);
     lowerHeadbandRight.generateVertices();
-    lowerHeadbandRight.translateMeshPreVAO();
-    meshes.push_back(&lowerHeadbandRight);
+    builder.addPart(lowerHeadbandRight);
 
     // Headband connectors
     CylinderMesh headbandConnectorLeft(vertexMode, UnitOfMeasure::CENTIMETER, -1, connectorRadius, connectorHeight, sectorCount);
@@ -160,8 +154,7 @@ void HeadsetMesh::generateVertices()
     headbandConnectorLeft.translateMesh(-10.3f, 0.0f, -2.1f);
     headbandConnectorLeft.setColor(color);
     headbandConnectorLeft.generateVertices();
-    headbandConnectorLeft.translateMeshPreVAO();
-    meshes.push_back(&headbandConnectorLeft);
+    builder.addPart(headbandConnectorLeft);
 
     CylinderMesh headbandConnectorRight(vertexMode, UnitOfMeasure::CENTIMETER, -1, connectorRadius, connectorHeight, sectorCount);
     headbandConnectorRight.setTextureUClamp(glm::vec2(0.0f, 3.0f / 7.0f));
@@ -170,8 +163,7 @@ void HeadsetMesh::generateVertices()
     headbandConnectorRight.translateMesh(10.3f, 0.0f, -2.1f);
     headbandConnectorRight.setColor(color);
     headbandConnectorRight.generateVertices();
-    headbandConnectorRight.translateMeshPreVAO();
-    meshes.push_back(&headbandConnectorRight);
+    builder.addPart(headbandConnectorRight);
 
     // Upper Earpiece
     CubeMesh upperEarpieceLeft(vertexMode, UnitOfMeasure::CENTIMETER, -1, upperEarpieceWidth, frameDepth, frameThickness);
@@ -181,8 +173,7 @@ void HeadsetMesh::generateVertices()
     upperEarpieceLeft.translateMesh(-(upperHeadbandSegmentWidth + 5.4f), 0.0f, -1.05f + (frameThickness / 2.0f));
     upperEarpieceLeft.setColor(color);
     upperEarpieceLeft.generateVertices();
-    upperEarpieceLeft.translateMeshPreVAO();
-    meshes.push_back(&upperEarpieceLeft);
+    builder.addPart(upperEarpieceLeft);
 
     CubeMesh upperEarpieceRight(vertexMode, UnitOfMeasure::CENTIMETER, -1, upperEarpieceWidth, frameDepth, frameThickness);
     upperEarpieceRight.setTextureUClamp(glm::vec2(0.0f, 3.0f / 7.0f));
@@ -191,8 +182,7 @@ void HeadsetMesh::generateVertices()
     upperEarpieceRight.translateMesh((upperHeadbandSegmentWidth + 5.4f), 0.0f, -1.05f + (frameThickness / 2.0f));
     upperEarpieceRight.setColor(color);
     upperEarpieceRight.generateVertices();
-    upperEarpieceRight.translateMeshPreVAO();
-    meshes.push_back(&upperEarpieceRight);
+    builder.addPart(upperEarpieceRight);
 
     // Earpieces
     CylinderMesh outterEarpieceLeft(vertexMode, UnitOfMeasure::CENTIMETER, -1, outterEarpieceRadius, outterEarpieceThickness, sectorCount);
@@ -203,8 +193,7 @@ void HeadsetMesh::generateVertices()
     outterEarpieceLeft.translateMesh(-(8.8f), 0.0f, 3.9f);
     outterEarpieceLeft.setColor(color);
     outterEarpieceLeft.generateVertices();
-    outterEarpieceLeft.translateMeshPreVAO();
-    meshes.push_back(&outterEarpieceLeft);
+    builder.addPart(outterEarpieceLeft);
 
     TorusMesh innerEarpieceLeft(vertexMode, UnitOfMeasure::CENTIMETER, -1, innerEarpieceRadius, innerEarpieceRadius - innerEarpieceThickness, sectorCount, sectorCount);
     innerEarpieceLeft.setTextureUClamp(glm::vec2(1.0f / 7.0f, 3.0f / 7.0f));
@@ -213,8 +202,7 @@ void HeadsetMesh::generateVertices()
     innerEarpieceLeft.translateMesh(-(8.2f - innerEarpieceThickness / 2.0f), 0.0f, 3.57f);
     innerEarpieceLeft.setColor(color);
     innerEarpieceLeft.generateVertices();
-    innerEarpieceLeft.translateMeshPreVAO();
-    meshes.push_back(&innerEarpieceLeft);
+    builder.addPart(innerEarpieceLeft);
 
     CylinderMesh outterEarpieceRight(vertexMode, UnitOfMeasure::CENTIMETER, -1, outterEarpieceRadius, outterEarpieceThickness, sectorCount);
     outterEarpieceRight.setTextureUClamp(glm::vec2(5.0f / 7.0f, 1.0f));
@@ -224,8 +212,7 @@ void HeadsetMesh::generateVertices()
     outterEarpieceRight.translateMesh((8.8f), 0.0f, 3.9f);
     outterEarpieceRight.setColor(color);
     outterEarpieceRight.generateVertices();
-    outterEarpieceRight.translateMeshPreVAO();
-    meshes.push_back(&outterEarpieceRight);
+    builder.addPart(outterEarpieceRight);
 
     TorusMesh innerEarpieceRight(vertexMode, UnitOfMeasure::CENTIMETER, -1, innerEarpieceRadius, innerEarpieceRadius - innerEarpieceThickness, sectorCount, sectorCount);
     innerEarpieceRight.setTextureUClamp(glm::vec2(1.0f / 7.0f, 3.0f / 7.0f));
@@ -234,25 +221,10 @@ void HeadsetMesh::generateVertices()
     innerEarpieceRight.translateMesh((8.2f - innerEarpieceThickness / 2.0f), 0.0f, 3.57f);
     innerEarpieceRight.setColor(color);
     innerEarpieceRight.generateVertices();
-    innerEarpieceRight.translateMeshPreVAO();
-    meshes.push_back(&innerEarpieceRight);
+    builder.addPart(innerEarpieceRight);
 
 
 
-    int verticesAdded = 0;
-
-    for (Mesh* meshPtr : meshes) {
-        for (GLfloat vertexValue : meshPtr->getVertexBuffer()) {
-            vertexBuffer.push_back(vertexValue);
-        }
-
-        for (GLuint elementValue : meshPtr->getElementBuffer()) {
-            elementBuffer.push_back(elementValue + verticesAdded);
-        }
-
-        verticesAdded = getVertexBufferCount();
-    }
-
     // Store any existing transformations
     glm::mat4 scaleTemp = scale;
     glm::mat4 rotationTemp = rotation;
@@ -272,10 +244,16 @@ void HeadsetMesh::generateVertices()
         scaleMesh(cmToInch, cmToInch, cmToInch);
     }
 
-    translateMeshPreVAO();
+    builder.build(vertexBuffer, elementBuffer, getModel());
 
     // Set back any existing transformations
     scale = scaleTemp;
     rotation = rotationTemp;
     translation = translationTemp;
+}
+
+float HeadsetMesh::setDetailLevel(int level)
+{
+    sectorCount = getLODSectorCount(fullSectorCount, level);
+    return 2.0f * glm::pi<float>() / sectorCount;
 }
\ No newline at end of file
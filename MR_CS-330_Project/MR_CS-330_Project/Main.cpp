@@ -7,6 +7,7 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"      // Image loading Utility functions
 #include <map>
+#include <cstdio>           // snprintf
 
 // GLM Math Header inclusions
 #include <glm/glm.hpp>
@@ -16,6 +17,11 @@
 #include "camera.h" // Camera class
 #include "InputHandler.h" // Input Handler class
 #include "ShaderManager.h" // Shader Manager class
+#include "TextureManager.h" // Texture Manager class
+#include "TextureResidencyManager.h" // Texture Residency Manager class
+#include "AllocationCounter.h" // Allocation Counter class
+#include "Benchmark.h" // Benchmark runs
+#include "GeometryCache.h" // Geometry Cache class
 
 // Primitive Meshes
 #include "PyramidMesh.h"
@@ -44,6 +50,12 @@ namespace
     const int WINDOW_WIDTH = 1028;
     const int WINDOW_HEIGHT = 720;
 
+    // Largest geometric error in pixels a level of detail may show on screen
+    const float MAX_LOD_PIXEL_ERROR = 1.0f;
+
+    // Length in pixels tessellated meshes aim for their edges to cover on screen
+    const float TESSELLATION_PIXELS_PER_EDGE = 8.0f;
+
     // Main GLFW window
     GLFWwindow* gWindow = nullptr;
     // Texture id
@@ -69,8 +81,17 @@ namespace
 
     // shader manager
     ShaderManager& gShaderManager = ShaderManager::getInstance();
+    // texture manager
+    TextureManager& gTextureManager = TextureManager::getInstance();
+    // texture residency manager, keeps resident mip levels under the texture memory budget
+    TextureResidencyManager& gTextureResidencyManager = TextureResidencyManager::getInstance();
+    const size_t TEXTURE_BUDGET_BYTES = 256 * 1024 * 1024;
     // store shader program id mapping by vertex mode
     std::map<VertexMode, GLuint> programIds;
+    // shader program building the vertices of pulled meshes from their parameters
+    GLuint gProceduralProgramId = 0;
+    // shader program building the vertices of tessellated meshes from patches
+    GLuint gTessellationProgramId = 0;
 
     // texture file path storage
     const char* texFilename;
@@ -90,6 +111,25 @@ namespace
         glm::vec3 specular;
     };
     DirectionalLight directionalLight;
+
+    // texture arrays currently bound per texture unit, to skip redundant rebinds between draws
+    GLuint gBoundTextureArrayIds[4] = { 0, 0, 0, 0 };
+
+    // bindless texture path, used instead of texture arrays when GL_ARB_bindless_texture is supported
+    bool gUseBindlessTextures = false;
+    GLuint gBindlessProgramId = 0;
+    GLuint gBindlessProceduralProgramId = 0;
+    GLuint gBindlessTessellationProgramId = 0;
+    GLuint gMaterialBufferId = 0;
+    std::map<const Mesh*, GLint> gMaterialIndices;    // index of each mesh's material in the material buffer
+
+    // heap allocations made while drawing the meshes, the draw path should make none
+    AllocationSnapshot gWorstFrameDrawAllocations;
+    size_t gFramesWithDrawAllocations = 0;
+
+    // meshlets considered and drawn by meshlet culling draws
+    size_t gMeshletsSubmitted = 0;
+    size_t gMeshletsDrawn = 0;
 }
 
 /* User-defined Function prototypes to:
@@ -100,70 +140,21 @@ namespace
 bool UInitialize(int, char* [], GLFWwindow** window);
 void UResizeWindow(GLFWwindow* window, int width, int height);
 void URenderMeshObject(Mesh& mesh);
+void UBindTextureArray(GLuint textureUnit, GLuint arrayTextureId);
+void USetMaterialTextureUnits(GLuint programId);
+float UProjectedSize(const Mesh& mesh, const glm::mat4& model);
+GLint UGetPointLightUniformLocation(GLuint programId, size_t index, const char* member);
+bool UCreateBindlessMaterials();
 void UDestroyShaderProgram(GLuint programId);
 bool UCreateTexture(const char* filename, GLuint& textureId);
 
 
 
-// TODO, move texture management to class
-// Images are loaded with Y axis going down, but OpenGL's Y axis goes up, so let's flip it
-void flipImageVertically(unsigned char* image, int width, int height, int channels)
-{
-    for (int j = 0; j < height / 2; ++j)
-    {
-        int index1 = j * width * channels;
-        int index2 = (height - 1 - j) * width * channels;
-
-        for (int i = width * channels; i > 0; --i)
-        {
-            unsigned char tmp = image[index1];
-            image[index1] = image[index2];
-            image[index2] = tmp;
-            ++index1;
-            ++index2;
-        }
-    }
-}
-
 /*Generate and load the texture*/
 bool UCreateTexture(const char* filename, GLuint& textureId)
 {
-    int width, height, channels;
-    unsigned char* image = stbi_load(filename, &width, &height, &channels, 0);
-    if (image)
-    {
-        flipImageVertically(image, width, height, channels);
-
-        glGenTextures(1, &textureId);
-        glBindTexture(GL_TEXTURE_2D, textureId);
-
-        // set the texture wrapping parameters
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        // set texture filtering parameters
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        if (channels == 3)
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-        else if (channels == 4)
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-        else
-        {
-            cout << "Not implemented to handle image with " << channels << " channels" << endl;
-            return false;
-        }
-
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        stbi_image_free(image);
-        glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
-
-        return true;
-    }
-
-    // Error loading the image
-    return false;
+    // Mip chains are cooked and cached by the texture manager
+    return gTextureManager.createTexture(filename, textureId);
 }
 
 
@@ -171,6 +162,15 @@ bool UCreateTexture(const char* filename, GLuint& textureId)
 
 int main(int argc, char* argv[])
 {
+    // Time the mesh builds instead of opening the scene
+    if (argc > 1 && string(argv[1]) == "--benchmark") {
+        Benchmark::runCompositeBuilds();
+        Benchmark::runParallelGeneration();
+        Benchmark::runCylinderGeneration();
+        Benchmark::runTriangleStrips();
+        return EXIT_SUCCESS;
+    }
+
     if (!UInitialize(argc, argv, &gWindow))
         return EXIT_FAILURE;
 
@@ -181,6 +181,10 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     if (!gShaderManager.createShaderProgram(programIds[POSITION_NORMAL_UV], VertexMode::POSITION_NORMAL_UV))
         return EXIT_FAILURE;
+    if (!gShaderManager.createProceduralShaderProgram(gProceduralProgramId))
+        return EXIT_FAILURE;
+    if (!gShaderManager.createTessellationShaderProgram(gTessellationProgramId))
+        return EXIT_FAILURE;
 
     // tell opengl for each sampler to which texture unit it belongs to (only has to be done once)
     glUseProgram(programIds[POSITION_UV]);
@@ -193,6 +197,15 @@ int main(int argc, char* argv[])
     glUseProgram(programIds[POSITION_NORMAL_UV]);
     // We set the texture as texture unit 0
     glUniform1i(glGetUniformLocation(programIds[POSITION_NORMAL_UV], "uTexture"), 0);
+    USetMaterialTextureUnits(programIds[POSITION_NORMAL_UV]);
+    USetMaterialTextureUnits(gProceduralProgramId);
+    USetMaterialTextureUnits(gTessellationProgramId);
+
+    // Decoded and mipped textures are cached between runs
+    gTextureManager.setCacheDirectory("../resources/texture_cache");
+
+    // Budget for resident texture mip levels
+    gTextureResidencyManager.setBudget(TEXTURE_BUDGET_BYTES);
 
     // Sets the background color of the window to Sky Blue (it will be implicitely used by glClear)
     glClearColor(0.43f, 0.71f, 0.72f, 1.0f);
@@ -227,6 +240,7 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
     tablePlane.addTextureID(gTextureId);
+    tablePlane.setTriangleStrips(true);
     tablePlane.generateVAO();
     sceneMeshes.push_back(&tablePlane);                
 
@@ -250,6 +264,10 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
     mtnDewCan.addTextureID(gTextureId);
+    mtnDewCan.setQuantizeVertices(true);    // 16 byte vertices instead of 32
+    mtnDewCan.setOptimizeVertexOrder(true);
+    mtnDewCan.setLODCount(4);
+    mtnDewCan.setCullMeshlets(true);
     mtnDewCan.generateVAO();
     sceneMeshes.push_back(&mtnDewCan);    
 
@@ -272,6 +290,10 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
     ps5Controller.addTextureID(gTextureId);
+    ps5Controller.setQuantizeVertices(true);    // 16 byte vertices instead of 32
+    ps5Controller.setOptimizeVertexOrder(true);
+    ps5Controller.setLODCount(4);
+    ps5Controller.setCullMeshlets(true);
     ps5Controller.generateVAO();
     sceneMeshes.push_back(&ps5Controller);
 
@@ -295,6 +317,10 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
     turtleBeachHeadset.addTextureID(gTextureId);
+    turtleBeachHeadset.setQuantizeVertices(true);    // 16 byte vertices instead of 32
+    turtleBeachHeadset.setOptimizeVertexOrder(true);
+    turtleBeachHeadset.setLODCount(4);
+    turtleBeachHeadset.setCullMeshlets(true);
     turtleBeachHeadset.generateVAO();
     sceneMeshes.push_back(&turtleBeachHeadset);
 
@@ -318,6 +344,10 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
     bearBackScratcher.addTextureID(gTextureId);
+    bearBackScratcher.setQuantizeVertices(true);    // 16 byte vertices instead of 32
+    bearBackScratcher.setOptimizeVertexOrder(true);
+    bearBackScratcher.setLODCount(4);
+    bearBackScratcher.setCullMeshlets(true);
     bearBackScratcher.generateVAO();
     sceneMeshes.push_back(&bearBackScratcher);
 
@@ -340,9 +370,95 @@ int main(int argc, char* argv[])
     }
     tvPlane.addTextureID(gTextureId);
     tvPlane.generateVertices();
+    tvPlane.setTriangleStrips(true);
     tvPlane.generateVAO();
     sceneMeshes.push_back(&tvPlane);
 
+    // Create Wooden Ball for scene with texture, its vertices are pulled from its parameters in the vertex shader
+    SphereMesh woodenBall(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, gProceduralProgramId, 3.0f, 50, 25);
+    woodenBall.generateVertices();
+    woodenBall.translateMesh(30.0f, 3.0f, 14.0f);
+    texFilename = "../resources/textures/table_top_1024x1024.png";
+    if (!UCreateTexture(texFilename, gTextureId))
+    {
+        cout << "Failed to load texture " << texFilename << endl;
+        return EXIT_FAILURE;
+    }
+    woodenBall.addTextureID(gTextureId);
+    texFilename = "../resources/textures/table_top_specular_1024x1024.png";
+    if (!UCreateTexture(texFilename, gTextureId))
+    {
+        cout << "Failed to load texture " << texFilename << endl;
+        return EXIT_FAILURE;
+    }
+    woodenBall.addTextureID(gTextureId);
+    woodenBall.setVertexPulling(true);
+    woodenBall.setLODCount(4);
+    woodenBall.generateVAO();
+    sceneMeshes.push_back(&woodenBall);
+
+    // Create Wooden Ring for scene with texture, its patches are subdivided by their size on screen
+    TorusMesh woodenRing(VertexMode::POSITION_NORMAL_UV, UnitOfMeasure::CENTIMETER, gTessellationProgramId, 4.0f, 2.0f, 50, 50);
+    woodenRing.generateVertices();
+    woodenRing.translateMesh(-30.0f, 1.0f, 15.0f);
+    woodenRing.rotateMesh(90.0f, 0.0f, 0.0f, Mesh::DEFAULT_ROTATION_ORDER);    // Lay the ring flat on the table
+    texFilename = "../resources/textures/table_top_1024x1024.png";
+    if (!UCreateTexture(texFilename, gTextureId))
+    {
+        cout << "Failed to load texture " << texFilename << endl;
+        return EXIT_FAILURE;
+    }
+    woodenRing.addTextureID(gTextureId);
+    texFilename = "../resources/textures/table_top_specular_1024x1024.png";
+    if (!UCreateTexture(texFilename, gTextureId))
+    {
+        cout << "Failed to load texture " << texFilename << endl;
+        return EXIT_FAILURE;
+    }
+    woodenRing.addTextureID(gTextureId);
+    woodenRing.setTessellation(true);
+    woodenRing.generateVAO();
+    sceneMeshes.push_back(&woodenRing);
+
+    // Warm loads map the texture cache, cold loads decode and cook the images
+    TextureLoadStats textureLoadStats = gTextureManager.getLoadStats();
+    cout << "INFO: Texture load: " << textureLoadStats.warmLoads << " warm in " << textureLoadStats.warmMilliseconds << " ms (cooked cold in "
+        << textureLoadStats.warmCookMilliseconds << " ms), " << textureLoadStats.coldLoads << " cold in " << textureLoadStats.coldMilliseconds << " ms" << endl;
+
+    // Sample the material maps through bindless handles when supported, otherwise pack the loaded textures
+    // into texture arrays, either way material changes between draws are only indices
+    if (gShaderManager.createBindlessShaderProgram(gBindlessProgramId)
+        && gShaderManager.createProceduralShaderProgram(gBindlessProceduralProgramId, true)
+        && gShaderManager.createTessellationShaderProgram(gBindlessTessellationProgramId, true)
+        && UCreateBindlessMaterials())
+    {
+        gUseBindlessTextures = true;
+        for (Mesh* mesh : sceneMeshes) {
+            if (mesh->getVertexMode() != POSITION_NORMAL_UV)
+                continue;
+
+            // Pulled and tessellated meshes switch to the bindless variant of the program that builds their vertices
+            if (mesh->getTessellation())
+                mesh->setShaderProgramId(gBindlessTessellationProgramId);
+            else if (mesh->getVertexPulling())
+                mesh->setShaderProgramId(gBindlessProceduralProgramId);
+            else
+                mesh->setShaderProgramId(gBindlessProgramId);
+        }
+        cout << "INFO: Using bindless textures" << endl;
+    }
+    else
+    {
+        if (gBindlessProgramId != 0)
+            UDestroyShaderProgram(gBindlessProgramId);
+        if (gBindlessProceduralProgramId != 0)
+            UDestroyShaderProgram(gBindlessProceduralProgramId);
+        if (gBindlessTessellationProgramId != 0)
+            UDestroyShaderProgram(gBindlessTessellationProgramId);
+
+        gTextureManager.packTextureArrays();
+    }
+
 
     // #########################
     // Create Scene Point Lights
@@ -397,6 +513,34 @@ int main(int argc, char* argv[])
     sceneMeshes.push_back(&hallwayLight);
     sceneMeshLights.push_back(&hallwayLight);
 
+    // Duplicate vertices of every mesh were welded when its VAO was generated
+    GLsizei unweldedVertexCount = 0;
+    GLsizei weldedVertexCount = 0;
+    for (Mesh* mesh : sceneMeshes) {
+        unweldedVertexCount += mesh->getUnweldedVertexCount();
+        weldedVertexCount += mesh->getVertexBufferCount();
+    }
+    cout << "INFO: Vertex welding: " << unweldedVertexCount << " vertices before, " << weldedVertexCount << " after" << endl;
+
+    // Hits are primitives that copied the geometry of an identical primitive instead of generating it
+    GeometryCacheStats geometryCacheStats = GeometryCache::getInstance().getStats();
+    cout << "INFO: Geometry cache: " << geometryCacheStats.hits << " hits, " << geometryCacheStats.misses << " misses, "
+        << geometryCacheStats.entries << " geometries (" << geometryCacheStats.bytes << " bytes)" << endl;
+
+    // Post-transform vertex cache use of the generated and uploaded triangle orders
+    VertexCacheStats unoptimizedCacheStats;
+    VertexCacheStats optimizedCacheStats;
+    for (Mesh* mesh : sceneMeshes) {
+        unoptimizedCacheStats.triangleCount += mesh->getUnoptimizedCacheStats().triangleCount;
+        unoptimizedCacheStats.vertexCount += mesh->getUnoptimizedCacheStats().vertexCount;
+        unoptimizedCacheStats.transformedCount += mesh->getUnoptimizedCacheStats().transformedCount;
+        optimizedCacheStats.triangleCount += mesh->getOptimizedCacheStats().triangleCount;
+        optimizedCacheStats.vertexCount += mesh->getOptimizedCacheStats().vertexCount;
+        optimizedCacheStats.transformedCount += mesh->getOptimizedCacheStats().transformedCount;
+    }
+    cout << "INFO: Vertex cache: ACMR " << unoptimizedCacheStats.getACMR() << " before, " << optimizedCacheStats.getACMR() << " after, ATVR "
+        << unoptimizedCacheStats.getATVR() << " before, " << optimizedCacheStats.getATVR() << " after" << endl;
+
     // render loop
     // -----------
     while (!glfwWindowShouldClose(gWindow))
@@ -416,9 +560,16 @@ int main(int argc, char* argv[])
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Render objects
+        AllocationSnapshot drawStart = AllocationCounter::getSnapshot();
         for (Mesh* mesh : sceneMeshes) {
             URenderMeshObject(*mesh);
         }
+        AllocationSnapshot drawAllocations = AllocationCounter::getAllocationsSince(drawStart);
+        if (drawAllocations.allocations > 0) {
+            ++gFramesWithDrawAllocations;
+            if (drawAllocations.bytes > gWorstFrameDrawAllocations.bytes)
+                gWorstFrameDrawAllocations = drawAllocations;
+        }
 
         // Random number generation for glowing effects
         std::random_device rd;
@@ -441,6 +592,9 @@ int main(int argc, char* argv[])
             tvGlow->glowColorShift(tvGlowColorShiftAmount, tvGlowColorShiftRedPercent, tvGlowColorShiftGreenPercent, tvGlowColorShiftBluePercent);
         }
 
+        // Stream in the mip levels drawn this frame needed, evict the least recently used over the budget
+        gTextureResidencyManager.updateResidency();
+
         // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
         glfwSwapBuffers(gWindow);    // Flips the the back buffer with the front buffer every frame.
         glfwPollEvents();
@@ -451,8 +605,32 @@ int main(int argc, char* argv[])
         mesh->destroyMesh();
     }
 
+    cout << "INFO: Texture residency: " << gTextureResidencyManager.getResidentBytes() / (1024 * 1024) << " MB resident of "
+        << gTextureResidencyManager.getBudget() / (1024 * 1024) << " MB budget, "
+        << gTextureResidencyManager.getStreamedBytes() / (1024 * 1024) << " MB streamed, "
+        << gTextureResidencyManager.getEvictedBytes() / (1024 * 1024) << " MB evicted" << endl;
+
+    if (AllocationCounter::isEnabled())
+        cout << "INFO: Draw allocations: " << gFramesWithDrawAllocations << " frames allocated, worst frame "
+            << gWorstFrameDrawAllocations.allocations << " allocations of " << gWorstFrameDrawAllocations.bytes << " bytes" << endl;
+
+    if (gMeshletsSubmitted > 0)
+        cout << "INFO: Meshlet culling: " << gMeshletsSubmitted - gMeshletsDrawn << " of " << gMeshletsSubmitted << " meshlets culled" << endl;
+
+    // Release material and texture data
+    if (gUseBindlessTextures)
+    {
+        glDeleteBuffers(1, &gMaterialBufferId);
+        UDestroyShaderProgram(gBindlessProgramId);
+        UDestroyShaderProgram(gBindlessProceduralProgramId);
+        UDestroyShaderProgram(gBindlessTessellationProgramId);
+    }
+    gTextureManager.destroyTextures();
+
     // Release shader program
     UDestroyShaderProgram(gProgramId);
+    UDestroyShaderProgram(gProceduralProgramId);
+    UDestroyShaderProgram(gTessellationProgramId);
 
     exit(EXIT_SUCCESS); // Terminates the program successfully
 }
@@ -550,9 +728,12 @@ void URenderMeshObject(Mesh& mesh)
     // Activate the VBOs contained within the mesh's VAO
     glBindVertexArray(mesh.getVAO());
 
+    // Screen coverage picks the texture mip levels to keep resident and the level of detail to draw
+    float projectedSize = UProjectedSize(mesh, model);
+
     if (mesh.getVertexMode() == POSITION_UV) {
         GLint enableTextureOverlayLoc = glGetUniformLocation(mesh.getShaderProgramId(), "enableTextureOverlay");
-        std::vector<GLuint> textureIds = mesh.getTextureIds();
+        std::span<const GLuint> textureIds = mesh.getTextureIds();
 
         if (textureIds.size() == 1) {
             glUniform1i(enableTextureOverlayLoc, false);
@@ -561,13 +742,26 @@ void URenderMeshObject(Mesh& mesh)
             glUniform1i(enableTextureOverlayLoc, true);
         }
 
-        for (int i = 0; i < textureIds.size(); ++i) {
+        for (size_t i = 0; i < textureIds.size(); ++i) {
             // bind textures on corresponding texture units
-            glActiveTexture(GL_TEXTURE0 + i);
-            glBindTexture(GL_TEXTURE_2D, textureIds.at(i));
+            glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(i));
+            glBindTexture(GL_TEXTURE_2D, textureIds[i]);
+            gTextureResidencyManager.requestTexture(textureIds[i], projectedSize);
         }
     }
     else if (mesh.getVertexMode() == POSITION_NORMAL_UV) {
+        // Tessellated meshes subdivide their patches by their size in the window
+        if (mesh.getTessellation()) {
+            glUniform2f(
+                glGetUniformLocation(mesh.getShaderProgramId(), "tessellation.viewportSize"),
+                (GLfloat)WINDOW_WIDTH, (GLfloat)WINDOW_HEIGHT
+            );
+            glUniform1f(
+                glGetUniformLocation(mesh.getShaderProgramId(), "tessellation.pixelsPerEdge"),
+                TESSELLATION_PIXELS_PER_EDGE
+            );
+        }
+
         // Temp Camera View Position
         glUniform3f(
             glGetUniformLocation(mesh.getShaderProgramId(), "viewPos"),
@@ -576,14 +770,6 @@ void URenderMeshObject(Mesh& mesh)
 
         // Temp Material Settings
         // TODO: Make dynamic to Mesh
-      glUniform1i(
-            glGetUniformLocation(mesh.getShaderProgramId(), "material.diffuse"),
-            0
-        );
-        glUniform1i(
-            glGetUniformLocation(mesh.getShaderProgramId(), "material.specular"),
-            1
-        );
         glUniform1f(
             glGetUniformLocation(mesh.getShaderProgramId(), "material.shininess"),
             32.0f
@@ -613,7 +799,7 @@ void URenderMeshObject(Mesh& mesh)
         // Temp Point Lights
         // TODO: Make dynamic point light its own class to handle any mesh for the visual indicator
         // not just a cube
-        std::vector<CubeLightMesh*> meshLights = sceneMeshLights;
+        const std::vector<CubeLightMesh*>& meshLights = sceneMeshLights;
 
         glUniform1i(
             glGetUniformLocation(mesh.getShaderProgramId(), "pointLightCount"),
@@ -621,7 +807,7 @@ void URenderMeshObject(Mesh& mesh)
         );
 
         for (size_t i = 0; i < meshLights.size(); ++i) {
-            CubeLightMesh& meshLight = *meshLights.at(i);
+            CubeLightMesh& meshLight = *meshLights[i];
             glm::vec3 lightPosition = glm::vec3(meshLight.getTranslation()[3]);
             glm::vec4 lightColor = meshLight.getColor();
             float ambientStrength = meshLight.getAmbientStrength();
@@ -630,38 +816,37 @@ void URenderMeshObject(Mesh& mesh)
             float constant = meshLight.getAttenuationConstant();
             float linear = meshLight.getAttenuationLinear();
             float quadratic = meshLight.getAttenuationQuadratic();
-            std::string index = std::to_string(i);
 
             glUniform3f(
-                glGetUniformLocation(mesh.getShaderProgramId(), ("pointLights[" + index + "].position").c_str()),
+                UGetPointLightUniformLocation(mesh.getShaderProgramId(), i, "position"),
                 lightPosition.x, lightPosition.y, lightPosition.z
             );
             glUniform3f(
-                glGetUniformLocation(mesh.getShaderProgramId(), ("pointLights[" + index + "].color").c_str()),
+                UGetPointLightUniformLocation(mesh.getShaderProgramId(), i, "color"),
                 lightColor.r, lightColor.g, lightColor.b
             );
             glUniform1f(
-                glGetUniformLocation(mesh.getShaderProgramId(), ("pointLights[" + index + "].ambientStrength").c_str()),
+                UGetPointLightUniformLocation(mesh.getShaderProgramId(), i, "ambientStrength"),
                 ambientStrength
             );
             glUniform1f(
-                glGetUniformLocation(mesh.getShaderProgramId(), ("pointLights[" + index + "].diffuseStrength").c_str()),
+                UGetPointLightUniformLocation(mesh.getShaderProgramId(), i, "diffuseStrength"),
                 diffuseStrength
             );
             glUniform1f(
-                glGetUniformLocation(mesh.getShaderProgramId(), ("pointLights[" + index + "].specularStrength").c_str()),
+                UGetPointLightUniformLocation(mesh.getShaderProgramId(), i, "specularStrength"),
                 specularStrength
             );
             glUniform1f(
-                glGetUniformLocation(mesh.getShaderProgramId(), ("pointLights[" + index + "].constant").c_str()),
+                UGetPointLightUniformLocation(mesh.getShaderProgramId(), i, "constant"),
                 constant
             );
             glUniform1f(
-                glGetUniformLocation(mesh.getShaderProgramId(), ("pointLights[" + index + "].linear").c_str()),
+                UGetPointLightUniformLocation(mesh.getShaderProgramId(), i, "linear"),
                 linear
             );
             glUniform1f(
-                glGetUniformLocation(mesh.getShaderProgramId(), ("pointLights[" + index + "].quadratic").c_str()),
+                UGetPointLightUniformLocation(mesh.getShaderProgramId(), i, "quadratic"),
                 quadratic
             );
         }
@@ -711,17 +896,64 @@ void URenderMeshObject(Mesh& mesh)
         );
 
         // Texture maps
-        std::vector<GLuint> textureIds = mesh.getTextureIds();
+        if (gUseBindlessTextures) {
+            // The material's handles are resident, selecting it is the only per-draw texture state
+            auto materialIndex = gMaterialIndices.find(&mesh);
+            glUniform1i(
+                glGetUniformLocation(mesh.getShaderProgramId(), "materialIndex"),
+                materialIndex != gMaterialIndices.end() ? materialIndex->second : 0
+            );
+        }
+        else {
+            std::span<const GLuint> textureIds = mesh.getTextureIds();
+            TextureArrayLayer diffuseLayer;
+            TextureArrayLayer specularLayer;
+            bool useTextureArrays = gTextureManager.getTextureArrayLayer(textureIds[0], diffuseLayer)
+                && gTextureManager.getTextureArrayLayer(textureIds[1], specularLayer);
+
+            glUniform1i(
+                glGetUniformLocation(mesh.getShaderProgramId(), "material.useTextureArrays"),
+                useTextureArrays
+            );
 
-        // bind textures on corresponding texture units
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, textureIds.at(0));
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, textureIds.at(1));
+            if (useTextureArrays) {
+                // Select the layers, the arrays are only rebound when the previous draw used different ones
+                glUniform1i(
+                    glGetUniformLocation(mesh.getShaderProgramId(), "material.diffuseLayer"),
+                    diffuseLayer.layer
+                );
+                glUniform1i(
+                    glGetUniformLocation(mesh.getShaderProgramId(), "material.specularLayer"),
+                    specularLayer.layer
+                );
+                UBindTextureArray(2, diffuseLayer.arrayTextureId);
+                UBindTextureArray(3, specularLayer.arrayTextureId);
+                gTextureResidencyManager.requestTexture(diffuseLayer.arrayTextureId, projectedSize);
+                gTextureResidencyManager.requestTexture(specularLayer.arrayTextureId, projectedSize);
+            }
+            else {
+                // bind textures on corresponding texture units
+                glActiveTexture(GL_TEXTURE0);
+                glBindTexture(GL_TEXTURE_2D, textureIds[0]);
+                glActiveTexture(GL_TEXTURE1);
+                glBindTexture(GL_TEXTURE_2D, textureIds[1]);
+                gTextureResidencyManager.requestTexture(textureIds[0], projectedSize);
+                gTextureResidencyManager.requestTexture(textureIds[1], projectedSize);
+            }
+        }
     }
 
     // Draws the triangles
-    glDrawElements(GL_TRIANGLES, mesh.getElementBuffer().size(), GL_UNSIGNED_SHORT, NULL); // Draws the triangle
+    size_t lod = mesh.selectLOD(projectedSize, MAX_LOD_PIXEL_ERROR);
+    if (mesh.getCullMeshlets()) {
+        // Skips the meshlets facing away from the camera or outside the view
+        glm::vec3 meshCameraPosition = glm::vec3(glm::inverse(model) * glm::vec4(gCamera.Position, 1.0f));
+        gMeshletsSubmitted += mesh.getLODs()[lod].meshletCount;
+        gMeshletsDrawn += mesh.drawMeshlets(lod, projection * view * model, meshCameraPosition, gCamera.CameraProjectionMode == PERSPECTIVE);
+    }
+    else {
+        mesh.drawElements(lod); // Draws the triangles, split into sub-draws for meshes past 16-bit elements
+    }
 
     // Deactivate the Vertex Array Object and texture
     glBindVertexArray(0);
@@ -730,6 +962,99 @@ void URenderMeshObject(Mesh& mesh)
 }
 
 
+// Estimate the size in pixels a mesh covers on screen from its bounding sphere and distance to the camera
+float UProjectedSize(const Mesh& mesh, const glm::mat4& model)
+{
+    glm::vec3 center = glm::vec3(model * glm::vec4(mesh.getBoundingCenter(), 1.0f));
+    float modelScale = glm::max(glm::length(glm::vec3(model[0])), glm::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+    float radius = mesh.getBoundingRadius() * modelScale;
+
+    // Matches the orthographic projection in URenderMeshObject
+    if (gCamera.CameraProjectionMode != PERSPECTIVE)
+        return 2.0f * radius / 100.0f * WINDOW_HEIGHT;
+
+    // Inside the bounding sphere the mesh can fill the screen
+    float distance = glm::length(center - gCamera.Position);
+    if (distance <= radius)
+        return static_cast<float>(WINDOW_HEIGHT);
+
+    return radius / (distance * glm::tan(glm::radians(gCamera.Zoom) * 0.5f)) * WINDOW_HEIGHT;
+}
+
+
+// Get the location of a member of a point light uniform without building a std::string per lookup
+GLint UGetPointLightUniformLocation(GLuint programId, size_t index, const char* member)
+{
+    char uniformName[64];
+    snprintf(uniformName, sizeof(uniformName), "pointLights[%zu].%s", index, member);
+    return glGetUniformLocation(programId, uniformName);
+}
+
+
+// Create the storage buffer of bindless materials, one per POSITION_NORMAL_UV mesh in the scene
+bool UCreateBindlessMaterials()
+{
+    // std430 layout of Material in the bindless shader
+    struct BindlessMaterial {
+        GLuint64 diffuse;
+        GLuint64 specular;
+        GLfloat shininess;
+        GLfloat padding;
+    };
+
+    if (!gTextureManager.makeTexturesResident())
+        return false;
+
+    std::vector<BindlessMaterial> materials;
+    for (Mesh* mesh : sceneMeshes) {
+        if (mesh->getVertexMode() != POSITION_NORMAL_UV)
+            continue;
+
+        std::span<const GLuint> textureIds = mesh->getTextureIds();
+        BindlessMaterial material = { 0, 0, 32.0f, 0.0f };
+        if (textureIds.size() < 2
+            || !gTextureManager.getTextureHandle(textureIds[0], material.diffuse)
+            || !gTextureManager.getTextureHandle(textureIds[1], material.specular))
+            return false;
+
+        gMaterialIndices[mesh] = static_cast<GLint>(materials.size());
+        materials.push_back(material);
+    }
+
+    glGenBuffers(1, &gMaterialBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, gMaterialBufferId);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, materials.size() * sizeof(BindlessMaterial), materials.data(), GL_STATIC_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gMaterialBufferId);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    return true;
+}
+
+
+// Bind a texture array on a texture unit unless it is already bound there
+void UBindTextureArray(GLuint textureUnit, GLuint arrayTextureId)
+{
+    if (gBoundTextureArrayIds[textureUnit] == arrayTextureId)
+        return;
+
+    glActiveTexture(GL_TEXTURE0 + textureUnit);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTextureId);
+    gBoundTextureArrayIds[textureUnit] = arrayTextureId;
+}
+
+
+// Tell opengl which texture unit each material sampler of a program belongs to (only has to be done once)
+// The material maps are texture units 0 and 1, and their texture arrays texture units 2 and 3
+void USetMaterialTextureUnits(GLuint programId)
+{
+    glUseProgram(programId);
+    glUniform1i(glGetUniformLocation(programId, "material.diffuse"), 0);
+    glUniform1i(glGetUniformLocation(programId, "material.specular"), 1);
+    glUniform1i(glGetUniformLocation(programId, "material.diffuseArray"), 2);
+    glUniform1i(glGetUniformLocation(programId, "material.specularArray"), 3);
+}
+
+
 // glfw: whenever the window size changed (by OS or user resize) this callback function executes
 void UResizeWindow(GLFWwindow* window, int width, int height)
 {
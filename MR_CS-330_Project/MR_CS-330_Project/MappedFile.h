@@ -0,0 +1,85 @@
+// MappedFile.h
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * Class representing a read-only memory mapped file.
+ * The mapped bytes stay valid until the file is closed or the object is destroyed.
+ */
+class MappedFile {
+public:
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * MappedFile constructor, no file is mapped.
+     */
+    MappedFile();
+
+    /**
+     * MappedFile destructor.
+     * Unmaps the file if one is mapped.
+     */
+    ~MappedFile();
+
+    // Prevent copying and assignment
+    MappedFile(const MappedFile&) = delete;
+    void operator=(const MappedFile&) = delete;
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the mapped bytes of the file.
+     *
+     * @return Pointer to the first byte, nullptr if no file is mapped.
+     */
+    const unsigned char* getData() const;
+
+    /**
+     * Get the size of the mapped file.
+     *
+     * @return The size in bytes.
+     */
+    const size_t getSize() const;
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Map a file for reading, unmapping the previously mapped file.
+     *
+     * @param filename Path of the file to map.
+     * @return True if the file was mapped.
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * Unmap the file.
+     */
+    void close();
+
+private:
+    // #############
+    // # Variables #
+    // #############
+
+    const unsigned char* data;      // Mapped bytes of the file
+    size_t size;                    // Size of the file in bytes
+#ifdef _WIN32
+    void* fileHandle;               // HANDLE of the open file
+    void* mappingHandle;            // HANDLE of the file mapping
+#else
+    int fileDescriptor;             // Descriptor of the open file
+#endif
+};
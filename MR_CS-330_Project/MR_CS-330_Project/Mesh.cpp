@@ -1,6 +1,39 @@
 #include "Mesh.h"
+#include "GeometryCache.h"
+#include "MeshOptimizer.h"
+#include "ThreadPool.h"
+#include "VertexTransform.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
 #include <random>
 
+// Unnamed namespace
+namespace
+{
+	GLsizeiptr getIndexSize(GLenum indexType)
+	{
+		if (indexType == GL_UNSIGNED_BYTE)
+			return sizeof(GLubyte);
+		if (indexType == GL_UNSIGNED_SHORT)
+			return sizeof(GLushort);
+		return sizeof(GLuint);
+	}
+
+	// Append elements relative to a base vertex, narrowed to the index type
+	template <typename Index>
+	void appendIndices(std::vector<unsigned char>& packedElements, std::span<const GLuint> elements, GLuint baseVertex)
+	{
+		size_t offset = packedElements.size();
+		packedElements.resize(offset + elements.size() * sizeof(Index));
+		Index* indices = reinterpret_cast<Index*>(packedElements.data() + offset);
+		for (size_t i = 0; i < elements.size(); ++i) {
+			indices[i] = static_cast<Index>(elements[i] - baseVertex);
+		}
+	}
+}
+
 
 // ##################
 // #                #
@@ -15,28 +48,19 @@
 
 
 Mesh::Mesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, glm::vec3 scale, glm::vec3 rotationDegrees, glm::vec3 translation, RotationOrder rotationOrder, GLuint shaderProgramId)
-	: vertexMode(vertexMode), unitOfMeasure(unitOfMeasure), floatsPerVertex(0), floatsPerColor(0), floatsPerNormal(0), floatsPerUV(0), stride(0), shaderProgramId(shaderProgramId)
+	: vertexMode(vertexMode), unitOfMeasure(unitOfMeasure), vertexBuffer(MeshBuildArena::getInstance().getResource()), elementBuffer(MeshBuildArena::getInstance().getResource()), indexType(GL_UNSIGNED_INT),
+	lodCount(1), cullMeshlets(false), triangleStrips(false), vertexPulling(false), tessellation(false), generationThreadCount(0), indirectBuffer(0), floatsPerVertex(0), floatsPerColor(0), floatsPerNormal(0), floatsPerUV(0), stride(0), shaderProgramId(shaderProgramId),
+	quantizeVertices(false), weldEpsilon(0.0f), unweldedVertexCount(0), optimizeVertexOrder(false), preVAOTransform(1.0f), dequantization(1.0f), boundingCenter(0.0f, 0.0f, 0.0f), boundingRadius(0.0f)
 {
-	if (vertexMode == POSITION_COLOR){
-		floatsPerVertex = DEFAULT_FLOATS_PER_VERTEX;
-		floatsPerColor = DEFAULT_FLOATS_PER_COLOR;
-	}
-	else if (vertexMode == POSITION_COLOR_UV) {
-		floatsPerVertex = DEFAULT_FLOATS_PER_VERTEX;
-		floatsPerColor = DEFAULT_FLOATS_PER_COLOR;
-		floatsPerUV = DEFAULT_FLOATS_PER_UV;
-	}
-	else if (vertexMode == POSITION_UV) {
-		floatsPerVertex = DEFAULT_FLOATS_PER_VERTEX;
-		floatsPerUV = DEFAULT_FLOATS_PER_UV;
-	}
-	else if (vertexMode == POSITION_NORMAL_UV) {
-		floatsPerVertex = DEFAULT_FLOATS_PER_VERTEX;
-		floatsPerNormal = DEFAULT_FLOATS_PER_NORMAL;
-		floatsPerUV = DEFAULT_FLOATS_PER_UV;
-	}
-
-	stride = sizeof(float) * (floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV);
+	// Attribute sizes come from the vertex format of the mode
+	visitVertexFormat(vertexMode, [this](auto vertex) {
+		using VertexType = decltype(vertex);
+		floatsPerVertex = VertexType::template getComponents<Position>();
+		floatsPerColor = VertexType::template getComponents<Color>();
+		floatsPerNormal = VertexType::template getComponents<Normal>();
+		floatsPerUV = VertexType::template getComponents<UV>();
+		stride = VertexType::STRIDE;
+	});
 
 	setScale(scale);
 	setRotation(rotationDegrees, rotationOrder);
@@ -67,12 +91,12 @@ const UnitOfMeasure Mesh::getUnitOfMeasure() const
 	return unitOfMeasure;
 }
 
-const std::vector<GLfloat> Mesh::getVertexBuffer() const
+const std::span<const GLfloat> Mesh::getVertexBuffer() const
 {
 	return vertexBuffer;
 }
 
-const std::vector<GLushort> Mesh::getElementBuffer() const
+const std::span<const GLuint> Mesh::getElementBuffer() const
 {
 	return elementBuffer;
 }
@@ -86,7 +110,7 @@ const GLsizeiptr Mesh::getVertexBufferSize() const
 const GLsizeiptr Mesh::getElementBufferSize() const
 {
 	// The number of items in the buffer multiplied by the size of each item
-	return elementBuffer.size() * sizeof(GLushort);
+	return elementBuffer.size() * getIndexSize(indexType);
 }
 
 const GLsizei Mesh::getVertexBufferCount() const
@@ -95,12 +119,52 @@ const GLsizei Mesh::getVertexBufferCount() const
 	return vertexBuffer.size() / (floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV);
 }
 
+const GLsizei Mesh::getUnweldedVertexCount() const
+{
+	return unweldedVertexCount;
+}
+
+const VertexCacheStats Mesh::getUnoptimizedCacheStats() const
+{
+	return unoptimizedCacheStats;
+}
+
+const VertexCacheStats Mesh::getOptimizedCacheStats() const
+{
+	return optimizedCacheStats;
+}
+
 const GLsizei Mesh::getElementBufferCount() const
 {
 	// The number of items in the buffer
 	return elementBuffer.size();
 }
 
+const GLenum Mesh::getIndexType() const
+{
+	return indexType;
+}
+
+const GLenum Mesh::getPrimitiveMode() const
+{
+	return triangleStrips ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
+}
+
+const std::span<const SubDraw> Mesh::getSubDraws() const
+{
+	return subDraws;
+}
+
+const std::span<const MeshLOD> Mesh::getLODs() const
+{
+	return lods;
+}
+
+const size_t Mesh::getMeshletCount() const
+{
+	return meshletCommands.size();
+}
+
 const GLuint Mesh::getFloatsPerVertex() const
 {
 	return floatsPerVertex;
@@ -158,8 +222,43 @@ const glm::mat4 Mesh::getTranslation() const
 
 const glm::mat4 Mesh::getModel() const
 {
-	// Standard formulat for Model
-	return translation * rotation * scale;
+	// Standard formulat for Model, quantized positions are dequantized first
+	return translation * rotation * scale * dequantization;
+}
+
+const glm::mat4 Mesh::getDequantization() const
+{
+	return dequantization;
+}
+
+const bool Mesh::getQuantizeVertices() const
+{
+	return quantizeVertices;
+}
+
+const bool Mesh::getCullMeshlets() const
+{
+	return cullMeshlets;
+}
+
+const bool Mesh::getTriangleStrips() const
+{
+	return triangleStrips;
+}
+
+const bool Mesh::getVertexPulling() const
+{
+	return vertexPulling;
+}
+
+const bool Mesh::getTessellation() const
+{
+	return tessellation;
+}
+
+const unsigned int Mesh::getGenerationThreadCount() const
+{
+	return generationThreadCount;
 }
 
 const GLuint Mesh::getShaderProgramId() const
@@ -167,7 +266,7 @@ const GLuint Mesh::getShaderProgramId() const
 	return shaderProgramId;
 }
 
-const std::vector<GLuint> Mesh::getTextureIds() const
+const std::span<const GLuint> Mesh::getTextureIds() const
 {
 	return textureIds;
 }
@@ -187,6 +286,16 @@ const glm::vec4 Mesh::getColor() const
 	return color;
 }
 
+const glm::vec3 Mesh::getBoundingCenter() const
+{
+	return boundingCenter;
+}
+
+const float Mesh::getBoundingRadius() const
+{
+	return boundingRadius;
+}
+
 
 // ##################
 // # Setter methods #
@@ -252,6 +361,56 @@ void Mesh::setColor(glm::vec4 color)
 	this->color = color;
 }
 
+void Mesh::setShaderProgramId(GLuint shaderProgramId)
+{
+	this->shaderProgramId = shaderProgramId;
+}
+
+void Mesh::setQuantizeVertices(bool quantizeVertices)
+{
+	this->quantizeVertices = quantizeVertices;
+}
+
+void Mesh::setWeldEpsilon(float weldEpsilon)
+{
+	this->weldEpsilon = weldEpsilon;
+}
+
+void Mesh::setOptimizeVertexOrder(bool optimizeVertexOrder)
+{
+	this->optimizeVertexOrder = optimizeVertexOrder;
+}
+
+void Mesh::setLODCount(GLuint lodCount)
+{
+	this->lodCount = lodCount;
+}
+
+void Mesh::setCullMeshlets(bool cullMeshlets)
+{
+	this->cullMeshlets = cullMeshlets;
+}
+
+void Mesh::setTriangleStrips(bool triangleStrips)
+{
+	this->triangleStrips = triangleStrips;
+}
+
+void Mesh::setVertexPulling(bool vertexPulling)
+{
+	this->vertexPulling = vertexPulling;
+}
+
+void Mesh::setTessellation(bool tessellation)
+{
+	this->tessellation = tessellation;
+}
+
+void Mesh::setGenerationThreadCount(unsigned int generationThreadCount)
+{
+	this->generationThreadCount = generationThreadCount;
+}
+
 
 // #################
 // # Other methods #
@@ -297,36 +456,10 @@ void Mesh::translateMesh(glm::vec3 translation)
 const void Mesh::translateMeshPreVAO()
 {
 	glm::mat4 model = getModel();
+	transformVertices(model);
 
-	if (vertexMode != POSITION_NORMAL_UV) {
-		// Transform each vertex in the vertexBuffer by the model matrix transformation
-		for (size_t i = 0; i < vertexBuffer.size(); i += (floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV)) {
-			glm::vec4 vertex(vertexBuffer[i], vertexBuffer[i + 1], vertexBuffer[i + 2], 1.0f);
-			vertex = model * vertex;
-
-			vertexBuffer[i] = vertex.x;
-			vertexBuffer[i + 1] = vertex.y;
-			vertexBuffer[i + 2] = vertex.z;
-		}
-	}
-	else if (vertexMode == POSITION_NORMAL_UV) {
-		// Transform each vertex and normal in the vertexBuffer by the model matrix transformation
-		for (size_t i = 0; i < vertexBuffer.size(); i += (floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV)) {
-			glm::vec4 vertex(vertexBuffer[i], vertexBuffer[i + 1], vertexBuffer[i + 2], 1.0f);
-			glm::vec3 vertexNormal(vertexBuffer[i + 3], vertexBuffer[i + 4], vertexBuffer[i + 5]);
-
-			vertex = model * vertex;
-			vertexNormal = glm::mat3(glm::transpose(glm::inverse(model))) * vertexNormal;
-
-			vertexBuffer[i] = vertex.x;
-			vertexBuffer[i + 1] = vertex.y;
-			vertexBuffer[i + 2] = vertex.z;
-
-			vertexBuffer[i + 3] = vertexNormal.x;
-			vertexBuffer[i + 4] = vertexNormal.y;
-			vertexBuffer[i + 5] = vertexNormal.z;
-		}
-	}
+	// Kept for the levels of detail, which are generated again without it
+	preVAOTransform = model * preVAOTransform;
 
 	// Reset the transformation values to default to account for the pre-VAO transformation after creating a VAO
 	setScale(DEFAULT_SCALE_VEC3);
@@ -336,56 +469,251 @@ const void Mesh::translateMeshPreVAO()
 
 void Mesh::destroyMesh()
 {
-	// Clear the GPU objects
-	glDeleteVertexArrays(1, &this->vao);
-	glDeleteBuffers(1, &this->vbo);
-	glDeleteBuffers(1, &this->ebo);
+	// Clear the GPU objects, pulled meshes only have a VAO
+	if (vao != 0) {
+		glDeleteVertexArrays(1, &this->vao);
+	}
+	if (vbo != 0) {
+		glDeleteBuffers(1, &this->vbo);
+	}
+	if (ebo != 0) {
+		glDeleteBuffers(1, &this->ebo);
+	}
+	if (indirectBuffer != 0) {
+		glDeleteBuffers(1, &this->indirectBuffer);
+	}
 }
 
 void Mesh::generateVAO()
 {
+	// Pulled and tessellated meshes upload nothing, the shaders build them from their parameters
+	if (vertexPulling || tessellation) {
+		if (generateProceduralVAO()) {
+			return;
+		}
+		vertexPulling = false;
+		tessellation = false;
+	}
+
+	unweldedVertexCount = getVertexBufferCount();
+	optimizeBuffers(unoptimizedCacheStats);
+	optimizedCacheStats = MeshOptimizer::analyzeVertexCache(elementBuffer, getVertexBufferCount());
+
+	calculateBounds();
+
+	// Lower levels of detail are appended to the same buffers
+	generateLODs();
+
+	// Meshlets are built from triangles, so meshes that cull them keep triangle lists
+	if (triangleStrips) {
+		triangleStrips = !cullMeshlets && buildTriangleStrips();
+	}
+
+	// Quantized vertices replace the floats on the GPU, the floats are kept for the CPU
+	std::vector<unsigned char> quantizedVertices;
+	if (quantizeVertices) {
+		quantizeVertices = quantizeVertexBuffer(quantizedVertices);
+	}
+
 	glGenVertexArrays(1, &vao); // we can also generate multiple VAOs or buffers at the same time
 	glBindVertexArray(vao);
 
 	// Create 2 buffers: first one for the vertex data; second one for the indices
 	glGenBuffers(1, &vbo);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo); // Activates the buffer
-	glBufferData(GL_ARRAY_BUFFER, getVertexBufferSize(), vertexBuffer.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
+	if (quantizeVertices) {
+		glBufferData(GL_ARRAY_BUFFER, quantizedVertices.size(), quantizedVertices.data(), GL_STATIC_DRAW);
+	}
+	else {
+		glBufferData(GL_ARRAY_BUFFER, getVertexBufferSize(), vertexBuffer.data(), GL_STATIC_DRAW); // Sends vertex or coordinate data to the GPU
+	}
 
 
+	// Upload the elements in the smallest type that addresses the vertices
+	std::vector<unsigned char> packedElements;
+	packElementBuffer(packedElements);
+
 	glGenBuffers(1, &ebo);
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, getElementBufferSize(), elementBuffer.data(), GL_STATIC_DRAW);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, packedElements.size(), packedElements.data(), GL_STATIC_DRAW);
+
+	// Meshlet draws are written to the indirect buffer every draw, at most one per meshlet
+	if (cullMeshlets) {
+		buildMeshlets();
+		glGenBuffers(1, &indirectBuffer);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+		glBufferData(GL_DRAW_INDIRECT_BUFFER, meshletCommands.size() * sizeof(DrawElementsIndirectCommand), NULL, GL_STREAM_DRAW);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
 
-	// Create Vertex Attribute Pointers
-	glVertexAttribPointer(0, floatsPerVertex, GL_FLOAT, GL_FALSE, stride, 0);
-	glEnableVertexAttribArray(0);
+	// Create Vertex Attribute Pointers from the vertex format of the mode
+	visitVertexFormat(vertexMode, [this](auto vertex) {
+		if (quantizeVertices) {
+			decltype(vertex)::setQuantizedAttributePointers();
+		}
+		else {
+			decltype(vertex)::setAttributePointers();
+		}
+	});
 
-	if (floatsPerColor != 0)
-	{
-		glVertexAttribPointer(1, floatsPerColor, GL_FLOAT, GL_FALSE, stride, (char*)(sizeof(float) * floatsPerVertex));
-		glEnableVertexAttribArray(1);
+	// Deactivate the Vertex Array Object
+	glBindVertexArray(0);
+}
+
+void Mesh::addTextureID(GLuint textureId)
+{
+	textureIds.push_back(textureId);
+}
+
+std::pmr::vector<GLfloat> Mesh::takeVertexBuffer()
+{
+	return std::move(vertexBuffer);
+}
+
+std::pmr::vector<GLuint> Mesh::takeElementBuffer()
+{
+	return std::move(elementBuffer);
+}
+
+size_t Mesh::selectLOD(float projectedSize, float maxPixelError) const
+{
+	// The projected size covers the bounding diameter and the errors are fractions of the radius
+	float pixelsPerError = projectedSize * 0.5f;
+	size_t lod = 0;
+	while (lod + 1 < lods.size() && lods[lod + 1].error * pixelsPerError <= maxPixelError) {
+		++lod;
 	}
+	return lod;
+}
 
-	if (floatsPerNormal != 0)
-	{
-		glVertexAttribPointer(2, floatsPerNormal, GL_FLOAT, GL_FALSE, stride, (char*)(sizeof(float) * (floatsPerVertex + floatsPerColor)));
-		glEnableVertexAttribArray(2);
+size_t Mesh::drawMeshlets(size_t lod, const glm::mat4& modelViewProjection, const glm::vec3& cameraPosition, bool perspective)
+{
+	if (lod >= lods.size() || lods[lod].meshletCount == 0) {
+		drawElements(lod);
+		return 0;
+	}
+	const MeshLOD& meshLOD = lods[lod];
+
+	// Captured by a single reference so the cull task fits in std::function's small buffer
+	struct {
+		glm::vec4 planes[6];
+		glm::vec3 cameraPosition;
+		bool perspective;
+		size_t firstMeshlet;
+	} cull;
+	cull.cameraPosition = cameraPosition;
+	cull.perspective = perspective;
+	cull.firstMeshlet = meshLOD.firstMeshlet;
+
+	// Frustum planes in the space of the VBO from the rows of the transform to clip space (Gribb and Hartmann)
+	glm::vec4 wRow(modelViewProjection[0][3], modelViewProjection[1][3], modelViewProjection[2][3], modelViewProjection[3][3]);
+	for (int axis = 0; axis < 3; ++axis) {
+		glm::vec4 row(modelViewProjection[0][axis], modelViewProjection[1][axis], modelViewProjection[2][axis], modelViewProjection[3][axis]);
+		cull.planes[axis * 2] = wRow + row;
+		cull.planes[axis * 2 + 1] = wRow - row;
+	}
+	for (glm::vec4& plane : cull.planes) {
+		plane /= glm::length(glm::vec3(plane));
 	}
 
-	if (floatsPerUV != 0)
-	{
-		glVertexAttribPointer(3, floatsPerUV, GL_FLOAT, GL_FALSE, stride, (char*)(sizeof(float) * (floatsPerVertex + floatsPerColor + floatsPerNormal)));
-		glEnableVertexAttribArray(3);
+	// Branch free over the bounds arrays so the compiler can vectorize it
+	auto cullTask = [this, &cull](size_t begin, size_t end) {
+		const float* centerX = meshletBounds.centerX.data() + cull.firstMeshlet;
+		const float* centerY = meshletBounds.centerY.data() + cull.firstMeshlet;
+		const float* centerZ = meshletBounds.centerZ.data() + cull.firstMeshlet;
+		const float* radius = meshletBounds.radius.data() + cull.firstMeshlet;
+		const float* coneAxisX = meshletBounds.coneAxisX.data() + cull.firstMeshlet;
+		const float* coneAxisY = meshletBounds.coneAxisY.data() + cull.firstMeshlet;
+		const float* coneAxisZ = meshletBounds.coneAxisZ.data() + cull.firstMeshlet;
+		const float* coneCutoff = meshletBounds.coneCutoff.data() + cull.firstMeshlet;
+		unsigned char* visibility = meshletVisibility.data() + cull.firstMeshlet;
+
+		for (size_t i = begin; i < end; ++i) {
+			bool visible = true;
+			for (const glm::vec4& plane : cull.planes) {
+				visible &= plane.x * centerX[i] + plane.y * centerY[i] + plane.z * centerZ[i] + plane.w >= -radius[i];
+			}
+
+			// Every triangle faces away when the direction to the meshlet is inside the normal cone, widened by the bounding sphere
+			if (cull.perspective) {
+				float toCenterX = centerX[i] - cull.cameraPosition.x;
+				float toCenterY = centerY[i] - cull.cameraPosition.y;
+				float toCenterZ = centerZ[i] - cull.cameraPosition.z;
+				float distance = std::sqrt(toCenterX * toCenterX + toCenterY * toCenterY + toCenterZ * toCenterZ);
+				visible &= toCenterX * coneAxisX[i] + toCenterY * coneAxisY[i] + toCenterZ * coneAxisZ[i] < coneCutoff[i] * distance + radius[i];
+			}
+
+			visibility[i] = visible;
+		}
+	};
+	unsigned int taskCount = static_cast<unsigned int>((meshLOD.meshletCount + MESHLETS_PER_CULL_TASK - 1) / MESHLETS_PER_CULL_TASK);
+	ThreadPool::getInstance().parallelFor(meshLOD.meshletCount, cullTask, taskCount);
+
+	// Neighboring meshlets are neighbors in the EBO, so runs of visible meshlets merge into one draw
+	visibleCommands.clear();
+	size_t drawnMeshlets = 0;
+	for (size_t i = meshLOD.firstMeshlet; i < meshLOD.firstMeshlet + meshLOD.meshletCount; ++i) {
+		if (!meshletVisibility[i]) {
+			continue;
+		}
+		++drawnMeshlets;
+
+		const DrawElementsIndirectCommand& command = meshletCommands[i];
+		if (!visibleCommands.empty() && visibleCommands.back().baseVertex == command.baseVertex
+			&& visibleCommands.back().firstIndex + visibleCommands.back().count == command.firstIndex) {
+			visibleCommands.back().count += command.count;
+		}
+		else {
+			visibleCommands.push_back(command);
+		}
 	}
 
-	// Deactivate the Vertex Array Object
-	glBindVertexArray(0);
+	if (!visibleCommands.empty()) {
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+		glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, visibleCommands.size() * sizeof(DrawElementsIndirectCommand), visibleCommands.data());
+		glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, NULL, static_cast<GLsizei>(visibleCommands.size()), 0);
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+	}
+
+	return drawnMeshlets;
 }
 
-void Mesh::addTextureID(GLuint textureId)
+void Mesh::drawElements(size_t lod) const
 {
-	textureIds.push_back(textureId);
+	if (lod >= lods.size()) {
+		return;
+	}
+
+	// Pulled and tessellated meshes send their parameters instead of reading buffers, 3 vertices per triangle or 1 per patch
+	if (vertexPulling || tessellation) {
+		const ProceduralGeometry& geometry = proceduralLODs[lod];
+		glUniform1i(glGetUniformLocation(shaderProgramId, "procedural.shape"), geometry.shape);
+		glUniform4fv(glGetUniformLocation(shaderProgramId, "procedural.dimensions"), 1, glm::value_ptr(geometry.dimensions));
+		glUniform2i(glGetUniformLocation(shaderProgramId, "procedural.divisions"), geometry.divisions.x, geometry.divisions.y);
+		glUniform4f(glGetUniformLocation(shaderProgramId, "procedural.textureClamp"), textureUClamp.x, textureUClampRatio, textureVClamp.x, textureVClampRatio);
+		if (tessellation) {
+			glPatchParameteri(GL_PATCH_VERTICES, 1);
+			glDrawArrays(GL_PATCHES, 0, geometry.vertexCount);
+		}
+		else {
+			glDrawArrays(GL_TRIANGLES, 0, geometry.vertexCount);
+		}
+		return;
+	}
+
+	// Restart is only enabled around strips, lists of byte elements address vertex 255
+	if (triangleStrips) {
+		glEnable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+	}
+
+	std::span<const SubDraw> lodSubDraws = std::span<const SubDraw>(subDraws).subspan(lods[lod].firstSubDraw, lods[lod].subDrawCount);
+	for (const SubDraw& subDraw : lodSubDraws) {
+		glDrawElementsBaseVertex(getPrimitiveMode(), subDraw.count, indexType, (void*)subDraw.offset, subDraw.baseVertex);
+	}
+
+	if (triangleStrips) {
+		glDisable(GL_PRIMITIVE_RESTART_FIXED_INDEX);
+	}
 }
 
 
@@ -428,9 +756,8 @@ const glm::mat4 Mesh::getRotationInOrder(glm::mat4 xRotation, glm::mat4 yRotatio
 const glm::vec4 Mesh::getRandomColor()
 {
 
-	// Random number generation
-	std::random_device rd;
-	std::mt19937 gen(rd());
+	// Random number generation, seeded once per thread rather than reseeding the engine for every mesh
+	thread_local std::mt19937 gen(std::random_device{}());
 	std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
 
 	// Random r, g, and b
@@ -464,3 +791,466 @@ const glm::vec3 Mesh::calculateNormal(const glm::vec3& vertex1, const glm::vec3&
 
 	return glm::normalize(normal);
 }
+
+void Mesh::calculateBounds()
+{
+	GLuint floatsPerVertexData = floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV;
+	if (vertexBuffer.empty()) {
+		boundingCenter = glm::vec3(0.0f, 0.0f, 0.0f);
+		boundingRadius = 0.0f;
+		return;
+	}
+
+	// Center the sphere on the axis aligned bounds
+	glm::vec3 minimum(vertexBuffer[0], vertexBuffer[1], vertexBuffer[2]);
+	glm::vec3 maximum = minimum;
+	for (size_t i = 0; i < vertexBuffer.size(); i += floatsPerVertexData) {
+		glm::vec3 vertex(vertexBuffer[i], vertexBuffer[i + 1], vertexBuffer[i + 2]);
+		minimum = glm::min(minimum, vertex);
+		maximum = glm::max(maximum, vertex);
+	}
+	boundingCenter = (minimum + maximum) * 0.5f;
+
+	// Radius reaches the farthest vertex
+	float radiusSquared = 0.0f;
+	for (size_t i = 0; i < vertexBuffer.size(); i += floatsPerVertexData) {
+		glm::vec3 offset = glm::vec3(vertexBuffer[i], vertexBuffer[i + 1], vertexBuffer[i + 2]) - boundingCenter;
+		radiusSquared = glm::max(radiusSquared, glm::dot(offset, offset));
+	}
+	boundingRadius = glm::sqrt(radiusSquared);
+}
+
+void Mesh::optimizeBuffers(VertexCacheStats& cacheStats)
+{
+	// Merge duplicate vertices so shared corners and seams are only shaded and stored once
+	if (weldEpsilon >= 0.0f) {
+		MeshOptimizer::weldVertices(vertexBuffer, elementBuffer, floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV, weldEpsilon);
+	}
+
+	// Reorder the generated row by row triangles for the vertex cache, then overdraw, then the vertices for fetching
+	cacheStats = MeshOptimizer::analyzeVertexCache(elementBuffer, getVertexBufferCount());
+	if (optimizeVertexOrder) {
+		MeshOptimizer::optimizeVertexCache(elementBuffer, getVertexBufferCount());
+
+		// Sorted clusters draw from anywhere in the mesh, which would break up the 16-bit sub-draw windows of larger meshes
+		if (static_cast<GLuint>(getVertexBufferCount()) <= MAX_UNSIGNED_SHORT_VERTICES) {
+			GLint normalOffset = -1;
+			visitVertexFormat(vertexMode, [&normalOffset](auto vertex) {
+				if constexpr (decltype(vertex)::template hasAttribute<Normal>()) {
+					normalOffset = static_cast<GLint>(decltype(vertex)::template getOffset<Normal>());
+				}
+			});
+			MeshOptimizer::optimizeOverdraw(elementBuffer, vertexBuffer, floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV, normalOffset);
+		}
+
+		MeshOptimizer::optimizeVertexFetch(vertexBuffer, elementBuffer, floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV);
+	}
+}
+
+void Mesh::transformVertices(const glm::mat4& model)
+{
+	// Transform each vertex (and normal) in the vertexBuffer by the model matrix transformation
+	VertexTransform::transformVertices(vertexBuffer, vertexBuffer, vertexMode, model);
+}
+
+void Mesh::generateLODs()
+{
+	lods.assign(1, { 0, getElementBufferCount(), 0, 0, 0.0f, 0, 0 });
+
+	float fullAngle = setDetailLevel(0);
+	if (lodCount <= 1 || fullAngle <= 0.0f) {
+		return;
+	}
+
+	// Keep full detail at the front of the buffers while each level is generated in them
+	std::pmr::vector<GLfloat> lodVertices = std::move(vertexBuffer);
+	std::pmr::vector<GLuint> lodElements = std::move(elementBuffer);
+	GLuint floatsPerAllAttributes = floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV;
+
+	// A chord between sectors strays radius * (1 - cos(angle / 2)) from the circle, at most the bounding radius
+	float fullError = 1.0f - std::cos(fullAngle * 0.5f);
+	float previousAngle = fullAngle;
+
+	for (GLuint level = 1; level < lodCount; ++level) {
+		float angle = setDetailLevel(static_cast<int>(level));
+		if (angle <= previousAngle) {
+			break;  // Already at the fewest sectors
+		}
+		previousAngle = angle;
+
+		vertexBuffer.clear();
+		elementBuffer.clear();
+		generateVertices();
+		if (preVAOTransform != glm::mat4(1.0f)) {
+			transformVertices(preVAOTransform);
+		}
+		unweldedVertexCount += getVertexBufferCount();
+		VertexCacheStats lodCacheStats;
+		optimizeBuffers(lodCacheStats);
+
+		MeshLOD lod = { static_cast<GLsizei>(lodElements.size()), getElementBufferCount(), 0, 0, (1.0f - std::cos(angle * 0.5f)) - fullError, 0, 0 };
+		lods.push_back(lod);
+
+		GLuint vertexOffset = static_cast<GLuint>(lodVertices.size() / floatsPerAllAttributes);
+		lodVertices.insert(lodVertices.end(), vertexBuffer.begin(), vertexBuffer.end());
+		for (GLuint element : elementBuffer) {
+			lodElements.push_back(element + vertexOffset);
+		}
+	}
+
+	setDetailLevel(0);
+	vertexBuffer = std::move(lodVertices);
+	elementBuffer = std::move(lodElements);
+
+	// Vertices a lower level shares with full detail (every other sector) are stored once
+	if (weldEpsilon >= 0.0f) {
+		MeshOptimizer::weldVertices(vertexBuffer, elementBuffer, floatsPerAllAttributes, weldEpsilon);
+	}
+}
+
+float Mesh::setDetailLevel(int /*level*/)
+{
+	return 0.0f;
+}
+
+bool Mesh::getProceduralGeometry(ProceduralGeometry& /*geometry*/) const
+{
+	return false;
+}
+
+int Mesh::getLODSectorCount(int sectorCount, int level)
+{
+	return std::max(std::min(sectorCount, MIN_LOD_SECTOR_COUNT), sectorCount >> level);
+}
+
+unsigned int Mesh::getGenerationTaskCount(size_t vertexCount) const
+{
+	unsigned int threadCount = (generationThreadCount == 0) ? ThreadPool::getInstance().getThreadCount() : generationThreadCount;
+	size_t taskCount = std::max<size_t>(1, vertexCount / VERTICES_PER_GENERATION_TASK);
+	return static_cast<unsigned int>(std::min<size_t>(taskCount, threadCount));
+}
+
+void Mesh::runGenerationTasks(size_t rowCount, unsigned int taskCount, const std::function<void(size_t, size_t)>& task)
+{
+	ThreadPool::getInstance().parallelFor(rowCount, task, taskCount);
+}
+
+GeometryKey Mesh::getGeometryKey(const char* type) const
+{
+	GeometryKey key(type);
+	key.add(vertexMode).add(textureUClamp).add(textureVClamp);
+
+	// The color is only part of the geometry when the vertices have it
+	visitVertexFormat(vertexMode, [&](auto vertex) {
+		if constexpr (decltype(vertex)::template hasAttribute<Color>()) {
+			key.add(color);
+		}
+	});
+	return key;
+}
+
+bool Mesh::loadCachedGeometry(const GeometryKey& key)
+{
+	std::shared_ptr<const CachedGeometry> geometry = GeometryCache::getInstance().find(key);
+	if (!geometry) {
+		return false;
+	}
+
+	// The buffers are changed by transforms and the VAO pipeline, so they get their own copy
+	vertexBuffer.assign(geometry->vertexBuffer.begin(), geometry->vertexBuffer.end());
+	elementBuffer.assign(geometry->elementBuffer.begin(), geometry->elementBuffer.end());
+	return true;
+}
+
+void Mesh::storeCachedGeometry(const GeometryKey& key)
+{
+	GeometryCache& geometryCache = GeometryCache::getInstance();
+	if (geometryCache.getEnabled()) {
+		geometryCache.insert(key, vertexBuffer, elementBuffer);
+	}
+}
+
+void Mesh::buildMeshlets()
+{
+	GLint normalOffset = -1;
+	visitVertexFormat(vertexMode, [&normalOffset](auto vertex) {
+		if constexpr (decltype(vertex)::template hasAttribute<Normal>()) {
+			normalOffset = static_cast<GLint>(decltype(vertex)::template getOffset<Normal>());
+		}
+	});
+
+	// Bounds are built from the float vertices in object space, then moved into the space of the VBO
+	glm::mat4 quantization = glm::inverse(dequantization);
+	float radiusScale = glm::length(glm::vec3(quantization[0]));
+	std::span<const GLuint> elements = elementBuffer;
+	GLsizeiptr indexSize = getIndexSize(indexType);
+
+	for (MeshLOD& lod : lods) {
+		lod.firstMeshlet = meshletCommands.size();
+
+		for (size_t i = lod.firstSubDraw; i < lod.firstSubDraw + lod.subDrawCount; ++i) {
+			// Packed elements keep the order of the element buffer
+			const SubDraw& subDraw = subDraws[i];
+			GLuint firstIndex = static_cast<GLuint>(subDraw.offset / indexSize);
+			std::vector<Meshlet> meshlets = MeshOptimizer::buildMeshlets(elements.subspan(firstIndex, subDraw.count), vertexBuffer,
+				floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV, normalOffset);
+
+			for (const Meshlet& meshlet : meshlets) {
+				meshletCommands.push_back({ meshlet.elementCount, 1, firstIndex + meshlet.firstElement, subDraw.baseVertex, 0 });
+
+				glm::vec3 center = glm::vec3(quantization * glm::vec4(meshlet.center, 1.0f));
+				meshletBounds.centerX.push_back(center.x);
+				meshletBounds.centerY.push_back(center.y);
+				meshletBounds.centerZ.push_back(center.z);
+				meshletBounds.radius.push_back(meshlet.radius * radiusScale);
+				meshletBounds.coneAxisX.push_back(meshlet.coneAxis.x);
+				meshletBounds.coneAxisY.push_back(meshlet.coneAxis.y);
+				meshletBounds.coneAxisZ.push_back(meshlet.coneAxis.z);
+				meshletBounds.coneCutoff.push_back(meshlet.coneCutoff);
+			}
+		}
+
+		lod.meshletCount = meshletCommands.size() - lod.firstMeshlet;
+	}
+
+	// Sized once so culling never allocates
+	meshletVisibility.resize(meshletCommands.size());
+	visibleCommands.reserve(meshletCommands.size());
+}
+
+bool Mesh::buildTriangleStrips()
+{
+	std::pmr::vector<GLuint> stripElements(elementBuffer.get_allocator());
+	std::vector<MeshLOD> stripLODs = lods;
+	std::span<const GLuint> elements = elementBuffer;
+
+	for (MeshLOD& lod : stripLODs) {
+		std::span<const GLuint> lodElements = elements.subspan(lod.firstElement, lod.elementCount);
+		lod.firstElement = static_cast<GLsizei>(stripElements.size());
+		MeshOptimizer::stripifyTriangles(lodElements, stripElements);
+		lod.elementCount = static_cast<GLsizei>(stripElements.size()) - lod.firstElement;
+	}
+
+	// Meshes of separate triangles (flat shaded caps, unwelded faces) are smaller as lists
+	if (stripElements.size() >= elementBuffer.size()) {
+		return false;
+	}
+
+	elementBuffer = std::move(stripElements);
+	lods = std::move(stripLODs);
+	return true;
+}
+
+bool Mesh::generateProceduralVAO()
+{
+	// The procedural shader outputs positions, normals, and UVs
+	ProceduralGeometry geometry;
+	if (vertexMode != POSITION_NORMAL_UV || !getProceduralGeometry(geometry)) {
+		return false;
+	}
+
+	// An empty VAO draws nothing with a program that reads vertex attributes, so keep the buffers instead
+	if (glGetUniformLocation(shaderProgramId, "procedural.shape") < 0) {
+		std::cout << "WARNING: Mesh: Shader program " << shaderProgramId << " does not build procedural vertices, uploading the vertices instead" << std::endl;
+		return false;
+	}
+
+	// The shader builds the vertices from the parameters alone, it can not apply transforms baked into them
+	if (preVAOTransform != glm::mat4(1.0f)) {
+		std::cout << "WARNING: Mesh: Vertices were transformed with translateMeshPreVAO, uploading the vertices instead" << std::endl;
+		return false;
+	}
+
+	// Drawing patches without tessellation stages is an invalid operation
+	if (tessellation && glGetUniformLocation(shaderProgramId, "tessellation.pixelsPerEdge") < 0) {
+		std::cout << "WARNING: Mesh: Shader program " << shaderProgramId << " has no tessellation stages, uploading the vertices instead" << std::endl;
+		return false;
+	}
+
+	unweldedVertexCount = getVertexBufferCount();
+	calculateBounds();
+	lods.clear();
+	proceduralLODs.clear();
+
+	// Patches are subdivided on screen, so a single grid of them replaces the levels of detail
+	if (tessellation) {
+		switch (geometry.shape) {
+		case PROCEDURAL_SPHERE:
+			geometry.divisions = glm::ivec2(TESSELLATION_PATCH_SECTORS, TESSELLATION_PATCH_SECTORS / 2);	// Stacks cover half a turn
+			break;
+		case PROCEDURAL_TORUS:
+			geometry.divisions = glm::ivec2(TESSELLATION_PATCH_SECTORS, TESSELLATION_PATCH_SECTORS);
+			break;
+		default:
+			geometry.divisions = glm::ivec2(TESSELLATION_PATCH_SECTORS, 3);	// Top, side, and bottom
+			break;
+		}
+		geometry.vertexCount = geometry.divisions.x * geometry.divisions.y;
+		lods.push_back({ 0, geometry.vertexCount, 0, 0, 0.0f, 0, 0 });
+		proceduralLODs.push_back(geometry);
+		glGenVertexArrays(1, &vao);
+		return true;
+	}
+
+	// Levels of detail only change the divisions, with the same errors as regenerated levels
+	float fullAngle = setDetailLevel(0);
+	float fullError = 1.0f - std::cos(fullAngle * 0.5f);
+	float previousAngle = 0.0f;
+
+	for (GLuint level = 0; level < std::max(lodCount, 1u); ++level) {
+		float angle = setDetailLevel(static_cast<int>(level));
+		if (level > 0 && angle <= previousAngle) {
+			break;  // Already at the fewest sectors
+		}
+		previousAngle = angle;
+
+		getProceduralGeometry(geometry);
+		lods.push_back({ 0, geometry.vertexCount, 0, 0, (level == 0) ? 0.0f : (1.0f - std::cos(angle * 0.5f)) - fullError, 0, 0 });
+		proceduralLODs.push_back(geometry);
+	}
+	setDetailLevel(0);
+
+	// Core profiles draw from a bound VAO even when it has no attributes
+	glGenVertexArrays(1, &vao);
+	return true;
+}
+
+void Mesh::packElementBuffer(std::vector<unsigned char>& packedElements)
+{
+	GLuint vertexCount = getVertexBufferCount();
+	std::span<const GLuint> elements = elementBuffer;
+	subDraws.clear();
+
+	// The restart index narrows to the largest value of the index type, which then can not address a vertex
+	bool fitsIndexType = triangleStrips ? vertexCount < MAX_UNSIGNED_SHORT_VERTICES : vertexCount <= MAX_UNSIGNED_SHORT_VERTICES;
+	if (fitsIndexType) {
+		bool fitsByteIndices = triangleStrips ? vertexCount < MAX_UNSIGNED_BYTE_VERTICES : vertexCount <= MAX_UNSIGNED_BYTE_VERTICES;
+		indexType = fitsByteIndices ? GL_UNSIGNED_BYTE : GL_UNSIGNED_SHORT;
+		for (MeshLOD& lod : lods) {
+			lod.firstSubDraw = subDraws.size();
+			lod.subDrawCount = 1;
+			subDraws.push_back({ lod.elementCount, static_cast<GLsizeiptr>(packedElements.size()), 0 });
+			if (indexType == GL_UNSIGNED_BYTE) {
+				appendIndices<GLubyte>(packedElements, elements.subspan(lod.firstElement, lod.elementCount), 0);
+			}
+			else {
+				appendIndices<GLushort>(packedElements, elements.subspan(lod.firstElement, lod.elementCount), 0);
+			}
+		}
+		return;
+	}
+
+	// Split the triangles of each level into runs whose vertices fit in 16-bit range from the lowest vertex of the run
+	struct ElementRun {
+		size_t begin;
+		size_t end;
+		GLuint baseVertex;
+	};
+	std::vector<ElementRun> runs;
+	bool fitsShortElements = !triangleStrips;   // Strips do not split into runs of whole triangles
+
+	for (MeshLOD& lod : lods) {
+		size_t lodEnd = static_cast<size_t>(lod.firstElement) + lod.elementCount;
+		ElementRun run = { static_cast<size_t>(lod.firstElement), static_cast<size_t>(lod.firstElement), UINT_MAX };
+		GLuint runMaxVertex = 0;
+		lod.firstSubDraw = runs.size();
+
+		for (size_t i = lod.firstElement; i < lodEnd && fitsShortElements; i += 3) {
+			size_t triangleEnd = std::min(i + 3, lodEnd);
+			GLuint triangleMin = *std::min_element(elementBuffer.begin() + i, elementBuffer.begin() + triangleEnd);
+			GLuint triangleMax = *std::max_element(elementBuffer.begin() + i, elementBuffer.begin() + triangleEnd);
+
+			if (triangleMax - triangleMin >= MAX_UNSIGNED_SHORT_VERTICES) {
+				// A single triangle spans too far for any base vertex
+				fitsShortElements = false;
+				break;
+			}
+
+			GLuint runMin = std::min(run.baseVertex, triangleMin);
+			GLuint runMax = std::max(runMaxVertex, triangleMax);
+			if (run.end > run.begin && runMax - runMin >= MAX_UNSIGNED_SHORT_VERTICES) {
+				runs.push_back(run);
+				run = { i, i, triangleMin };
+				runMin = triangleMin;
+				runMax = triangleMax;
+			}
+
+			run.baseVertex = runMin;
+			runMaxVertex = runMax;
+			run.end = triangleEnd;
+		}
+		runs.push_back(run);
+		lod.subDrawCount = runs.size() - lod.firstSubDraw;
+	}
+
+	if (!fitsShortElements) {
+		indexType = GL_UNSIGNED_INT;
+		for (MeshLOD& lod : lods) {
+			lod.firstSubDraw = subDraws.size();
+			lod.subDrawCount = 1;
+			subDraws.push_back({ lod.elementCount, static_cast<GLsizeiptr>(packedElements.size()), 0 });
+			appendIndices<GLuint>(packedElements, elements.subspan(lod.firstElement, lod.elementCount), 0);
+		}
+		return;
+	}
+
+	indexType = GL_UNSIGNED_SHORT;
+	for (const ElementRun& elementRun : runs) {
+		SubDraw subDraw;
+		subDraw.count = static_cast<GLsizei>(elementRun.end - elementRun.begin);
+		subDraw.offset = static_cast<GLsizeiptr>(packedElements.size());
+		subDraw.baseVertex = static_cast<GLint>(elementRun.baseVertex);
+		appendIndices<GLushort>(packedElements, elements.subspan(elementRun.begin, elementRun.end - elementRun.begin), elementRun.baseVertex);
+		subDraws.push_back(subDraw);
+	}
+}
+
+bool Mesh::quantizeVertexBuffer(std::vector<unsigned char>& quantizedVertices)
+{
+	GLuint floatsPerVertexData = floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV;
+	GLuint uvOffset = floatsPerVertex + floatsPerColor + floatsPerNormal;
+	if (vertexBuffer.empty()) {
+		return false;
+	}
+
+	// Normalized UVs can not represent tiling coordinates
+	if (floatsPerUV != 0) {
+		for (size_t i = uvOffset; i < vertexBuffer.size(); i += floatsPerVertexData) {
+			if (vertexBuffer[i] < 0.0f || vertexBuffer[i] > 1.0f || vertexBuffer[i + 1] < 0.0f || vertexBuffer[i + 1] > 1.0f) {
+				return false;
+			}
+		}
+	}
+
+	// Positions are stored relative to the bounds, with one scale so dequantizing does not skew normals
+	glm::vec3 minimum(vertexBuffer[0], vertexBuffer[1], vertexBuffer[2]);
+	glm::vec3 maximum = minimum;
+	for (size_t i = 0; i < vertexBuffer.size(); i += floatsPerVertexData) {
+		glm::vec3 vertex(vertexBuffer[i], vertexBuffer[i + 1], vertexBuffer[i + 2]);
+		minimum = glm::min(minimum, vertex);
+		maximum = glm::max(maximum, vertex);
+	}
+	glm::vec3 halfExtent = (maximum - minimum) * 0.5f;
+
+	VertexQuantization quantization;
+	quantization.center = (minimum + maximum) * 0.5f;
+	quantization.scale = glm::max(halfExtent.x, glm::max(halfExtent.y, halfExtent.z));
+	if (quantization.scale <= 0.0f) {
+		quantization.scale = 1.0f;
+	}
+
+	visitVertexFormat(vertexMode, [&](auto vertex) {
+		using VertexType = decltype(vertex);
+		size_t vertexCount = vertexBuffer.size() / VertexType::FLOATS_PER_VERTEX;
+		quantizedVertices.resize(vertexCount * VertexType::QUANTIZED_STRIDE);
+		for (size_t i = 0; i < vertexCount; ++i) {
+			VertexType::quantize(&vertexBuffer[i * VertexType::FLOATS_PER_VERTEX], quantization, &quantizedVertices[i * VertexType::QUANTIZED_STRIDE]);
+		}
+	});
+
+	dequantization = glm::translate(quantization.center) * glm::scale(glm::vec3(quantization.scale));
+	boundingCenter = (boundingCenter - quantization.center) / quantization.scale;
+	boundingRadius = boundingRadius / quantization.scale;
+
+	return true;
+}
@@ -1,20 +1,22 @@
 // Mesh.h
 #pragma once
 
+#include <functional>
 #include <iostream>
 #include <GL/glew.h>
+#include <memory_resource>
+#include <span>
 #include <vector>
 #include <glm/glm.hpp>
 #include <glm/gtx/transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "BakedGeometry.h"
+#include "MeshBuildArena.h"
+#include "MeshOptimizer.h"
+#include "ParametricSurface.h"
+#include "VertexFormat.h"
 
-// Enum for VertexMode
-enum VertexMode {
-    POSITION_COLOR,         // (x, y, z, r, g, b, a)
-    POSITION_UV,            // (x, y, z, u, v)
-    POSITION_COLOR_UV,      // (x, y, z, r, g, b, a, u, v)
-    POSITION_NORMAL_UV      // (x, y, z, nx, ny, nz, u, v)
-};
+class GeometryKey;
 
 // Enum for UnitOfMeasure
 enum UnitOfMeasure {
@@ -34,6 +36,73 @@ enum RotationOrder {
     X_Z_Y
 };
 
+
+// Enum for ProceduralShape
+// Determines the shape the procedural vertex shader builds, the values match the shader
+enum ProceduralShape {
+    PROCEDURAL_NONE,
+    PROCEDURAL_SPHERE,
+    PROCEDURAL_TORUS,
+    PROCEDURAL_FRUSTUM
+};
+
+/**
+ * Struct representing a range of the element buffer drawn with a single draw call.
+ */
+struct SubDraw {
+    GLsizei count;                          // Number of elements in the range
+    GLsizeiptr offset;                      // Byte offset of the first element in the EBO
+    GLint baseVertex;                       // Added to every element of the range to get the vertex index
+};
+
+/**
+ * Struct representing a level of detail of a Mesh, a range of the element buffer into the shared vertex buffer.
+ */
+struct MeshLOD {
+    GLsizei firstElement;                   // Index of the first element of the level in the element buffer
+    GLsizei elementCount;                   // Number of elements in the level
+    size_t firstSubDraw;                    // Index of the first sub-draw of the level
+    size_t subDrawCount;                    // Number of sub-draws of the level
+    float error;                            // Distance the level strays from the full detail surface, as a fraction of the bounding radius
+    size_t firstMeshlet;                    // Index of the first meshlet of the level
+    size_t meshletCount;                    // Number of meshlets of the level (0 = meshlets are not culled)
+};
+
+/**
+ * Struct matching the layout of a command in a GL_DRAW_INDIRECT_BUFFER for glMultiDrawElementsIndirect.
+ */
+struct DrawElementsIndirectCommand {
+    GLuint count;                           // Number of elements to draw
+    GLuint instanceCount;                   // Number of instances to draw
+    GLuint firstIndex;                      // Index of the first element in the EBO
+    GLint baseVertex;                       // Added to every element to get the vertex index
+    GLuint baseInstance;                    // First instance index
+};
+
+/**
+ * Struct representing the culling bounds of meshlets, one array per value so the culling loop vectorizes.
+ */
+struct MeshletBounds {
+    std::vector<float> centerX;             // Bounding sphere centers
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> radius;              // Bounding sphere radii
+    std::vector<float> coneAxisX;           // Normal cone axes
+    std::vector<float> coneAxisY;
+    std::vector<float> coneAxisZ;
+    std::vector<float> coneCutoff;          // Normal cone cutoffs (1 = never back-facing)
+};
+
+/**
+ * Struct representing the parameters the procedural vertex shader builds the vertices of a parametric Mesh from.
+ */
+struct ProceduralGeometry {
+    ProceduralShape shape;                  // Shape to build
+    glm::vec4 dimensions;                   // Sphere radius, torus center and tube radius, or frustum top radius, bottom radius, and height
+    glm::ivec2 divisions;                   // Slices and stacks, or sectors and 0 (patches around and down when tessellated)
+    GLsizei vertexCount;                    // Number of vertices to draw, 3 per triangle (1 per patch when tessellated)
+};
+
 /**
  * Class representing a Mesh object with transformations.
  */
@@ -88,18 +157,21 @@ public:
     const UnitOfMeasure getUnitOfMeasure() const;
 
     /**
-     * Get the vertex buffer of the Mesh.
+     * Get a read-only view of the vertex buffer of the Mesh.
+     * The view is invalidated when the vertex buffer changes.
      *
-     * @return The vertex buffer as a vector of GLfloat.
+     * @return The vertex buffer as a span of GLfloat.
      */
-    const std::vector<GLfloat> getVertexBuffer() const;
+    const std::span<const GLfloat> getVertexBuffer() const;
 
     /**
-     * Get the element buffer of the Mesh.
+     * Get a read-only view of the element buffer of the Mesh.
+     * Elements are 32-bit while building, they are packed to the index type when generating the VAO.
+     * The view is invalidated when the element buffer changes.
      *
-     * @return The element buffer as a vector of GLushort.
+     * @return The element buffer as a span of GLuint.
      */
-    const std::vector<GLushort> getElementBuffer() const;
+    const std::span<const GLuint> getElementBuffer() const;
 
     /**
      * Get the size of the vertex buffer.
@@ -109,7 +181,7 @@ public:
     const GLsizeiptr getVertexBufferSize() const;
 
     /**
-     * Get the size of the element buffer.
+     * Get the size of the element buffer packed to the index type.
      *
      * @return The size of the element buffer as GLsizeiptr.
      */
@@ -122,6 +194,27 @@ public:
      */
     const GLsizei getVertexBufferCount() const;
 
+    /**
+     * Get the count of vertex sets before duplicate vertices were welded when generating the VAO.
+     *
+     * @return The count of vertex sets before welding as GLsizei.
+     */
+    const GLsizei getUnweldedVertexCount() const;
+
+    /**
+     * Get the post-transform vertex cache stats of the element order before it was optimized when generating the VAO.
+     *
+     * @return The cache stats.
+     */
+    const VertexCacheStats getUnoptimizedCacheStats() const;
+
+    /**
+     * Get the post-transform vertex cache stats of the element order uploaded when generating the VAO.
+     *
+     * @return The cache stats.
+     */
+    const VertexCacheStats getOptimizedCacheStats() const;
+
     /**
      * Get the count of elements in the element buffer.
      *
@@ -129,6 +222,44 @@ public:
      */
     const GLsizei getElementBufferCount() const;
 
+    /**
+     * Get the type of the elements in the EBO, chosen from the vertex count when generating the VAO.
+     *
+     * @return GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT, or GL_UNSIGNED_INT.
+     */
+    const GLenum getIndexType() const;
+
+    /**
+     * Get the primitive the element buffer is drawn as.
+     *
+     * @return GL_TRIANGLE_STRIP if the VAO was generated with triangle strips, otherwise GL_TRIANGLES.
+     */
+    const GLenum getPrimitiveMode() const;
+
+    /**
+     * Get the ranges of the element buffer drawn with separate draw calls.
+     * Meshes with more vertices than 16-bit elements can address are split into several ranges,
+     * each addressing its vertices from a base vertex.
+     *
+     * @return The sub-draws.
+     */
+    const std::span<const SubDraw> getSubDraws() const;
+
+    /**
+     * Get the levels of detail stored in the buffers, from full detail to coarsest.
+     * Every Mesh has at least the full detail level.
+     *
+     * @return The levels of detail.
+     */
+    const std::span<const MeshLOD> getLODs() const;
+
+    /**
+     * Get the number of meshlets built for culling, across every level of detail.
+     *
+     * @return The number of meshlets.
+     */
+    const size_t getMeshletCount() const;
+
     /**
      * Get the number of values per vertex attribute.
      *
@@ -208,11 +339,62 @@ public:
 
     /**
      * Get the model matrix (combination of translation, rotation, and scale) of the Mesh.
+     * Includes the dequantization of quantized vertices.
      *
      * @return The model matrix as a glm::mat4.
      */
     const glm::mat4 getModel() const;
 
+    /**
+     * Get the transform from quantized positions in the VBO back to object space.
+     * Identity unless the vertices were quantized.
+     *
+     * @return The dequantization matrix as a glm::mat4.
+     */
+    const glm::mat4 getDequantization() const;
+
+    /**
+     * Get if the vertices in the VBO are quantized.
+     *
+     * @return True if the vertices are quantized.
+     */
+    const bool getQuantizeVertices() const;
+
+    /**
+     * Get if meshlets are built for culling when generating the VAO.
+     *
+     * @return True if draws can cull meshlets.
+     */
+    const bool getCullMeshlets() const;
+
+    /**
+     * Get if the elements are drawn as triangle strips.
+     *
+     * @return True if the elements are triangle strips separated by the restart index.
+     */
+    const bool getTriangleStrips() const;
+
+    /**
+     * Get if the vertices are built by the procedural vertex shader instead of read from a VBO.
+     *
+     * @return True if the Mesh is drawn with vertex pulling.
+     */
+    const bool getVertexPulling() const;
+
+    /**
+     * Get if the Mesh is drawn as patches the tessellation shaders subdivide by their size on screen.
+     *
+     * @return True if the Mesh is drawn as tessellated patches.
+     */
+    const bool getTessellation() const;
+
+    /**
+     * Get the most threads the vertices are generated with.
+     *
+     * @return The number of threads (0 = every thread of the pool).
+     */
+    const unsigned int getGenerationThreadCount() const;
+
     /**
      * Get the ID of the shader program for rendering.
      *
@@ -221,11 +403,11 @@ public:
     const GLuint getShaderProgramId() const;
 
     /**
-     * Get the IDs of the textures for rendering.
+     * Get a read-only view of the IDs of the textures for rendering.
      *
      * @return The IDs of the textures for rendering.
      */
-    const std::vector<GLuint> getTextureIds() const;
+    const std::span<const GLuint> getTextureIds() const;
 
     /**
      * Get the Min and Max clamp values for texture U coordniate clamping for subsection of texture use
@@ -248,6 +430,22 @@ public:
      * @return The color to use when rendering with a color mode.
      */
     const glm::vec4 getColor() const;
+
+    /**
+     * Get the center of the bounding sphere of the Mesh vertices in the VBO, before the model matrix.
+     * Calculated when generating the VAO.
+     *
+     * @return The bounding sphere center.
+     */
+    const glm::vec3 getBoundingCenter() const;
+
+    /**
+     * Get the radius of the bounding sphere of the Mesh vertices in the VBO, before the model matrix.
+     * Calculated when generating the VAO.
+     *
+     * @return The bounding sphere radius.
+     */
+    const float getBoundingRadius() const;
     
 
     // ##################
@@ -330,6 +528,104 @@ public:
      */
     void setColor(glm::vec4 color);
 
+    /**
+     * Set the ID of the shader program for rendering
+     *
+     * @param shaderProgramId The ID of the shader program for rendering.
+     */
+    void setShaderProgramId(GLuint shaderProgramId);
+
+    /**
+     * Set if the vertices are quantized when generating the VAO: normalized int16 positions relative
+     * to the bounds, 10-bit normals, 8-bit colors, and 16-bit UVs (16 instead of 32 bytes for POSITION_NORMAL_UV).
+     * Meshes with UVs outside [0, 1] are left unquantized.
+     * Must be used before generating the VAO.
+     *
+     * @param quantizeVertices True to quantize the vertices.
+     */
+    void setQuantizeVertices(bool quantizeVertices);
+
+    /**
+     * Set the tolerance duplicate vertices are welded with when generating the VAO.
+     * Vertices match when every attribute rounds to the same multiple of the tolerance.
+     * Must be used before generating the VAO.
+     *
+     * @param weldEpsilon The tolerance (0 = exact matching, negative = no welding).
+     */
+    void setWeldEpsilon(float weldEpsilon);
+
+    /**
+     * Set if the triangles and vertices are reordered when generating the VAO: triangles for the
+     * post-transform vertex cache then overdraw, vertices for fetch locality.
+     * Must be used before generating the VAO.
+     *
+     * @param optimizeVertexOrder True to reorder the triangles and vertices.
+     */
+    void setOptimizeVertexOrder(bool optimizeVertexOrder);
+
+    /**
+     * Set the number of levels of detail generated when generating the VAO, each level regenerating
+     * the vertices with half the sectors around curved sections of the previous one.
+     * Meshes without curved sections only have the full detail level.
+     * Must be used before generating the VAO.
+     *
+     * @param lodCount The number of levels including full detail.
+     */
+    void setLODCount(GLuint lodCount);
+
+    /**
+     * Set if the triangles are split into meshlets when generating the VAO, so drawMeshlets can skip
+     * the back-facing and off-screen ones.
+     * Must be used before generating the VAO.
+     *
+     * @param cullMeshlets True to build meshlets.
+     */
+    void setCullMeshlets(bool cullMeshlets);
+
+    /**
+     * Set if the triangles are joined into triangle strips when generating the VAO, drawn with
+     * GL_PRIMITIVE_RESTART_FIXED_INDEX between strips. Meshes that cull meshlets keep triangle lists, and the
+     * lists are also kept when the strips would not have fewer elements.
+     * After generating the VAO the element buffer holds the strips.
+     * Must be used before generating the VAO.
+     *
+     * @param triangleStrips True to draw triangle strips.
+     */
+    void setTriangleStrips(bool triangleStrips);
+
+    /**
+     * Set if the VAO is generated without a VBO or EBO, the vertices being built from gl_VertexID by the
+     * program from ShaderManager::createProceduralShaderProgram, which must be set as the shader program.
+     * Only parametric meshes in POSITION_NORMAL_UV mode can be pulled, other meshes, meshes with a program that does
+     * not build procedural vertices, and meshes transformed with translateMeshPreVAO keep their buffers.
+     * Vertices are still generated for the bounds, levels of detail only change the divisions.
+     * Must be used before generating the VAO.
+     *
+     * @param vertexPulling True to build the vertices on the GPU.
+     */
+    void setVertexPulling(bool vertexPulling);
+
+    /**
+     * Set if the VAO is generated without a VBO or EBO and the Mesh is drawn as a grid of patches, which the program
+     * from ShaderManager::createTessellationShaderProgram subdivides per edge by its size on screen and must be set
+     * as the shader program. Patches cover TESSELLATION_PATCH_SECTORS sectors around each full turn, and replace the
+     * levels of detail. Only parametric meshes in POSITION_NORMAL_UV mode can be tessellated, other meshes and meshes with
+     * a program without tessellation stages keep their buffers.
+     * Must be used before generating the VAO.
+     *
+     * @param tessellation True to subdivide the Mesh on the GPU.
+     */
+    void setTessellation(bool tessellation);
+
+    /**
+     * Set the most threads the vertices are generated with. Meshes with curved sections generate bands of
+     * sectors in parallel once they have more than VERTICES_PER_GENERATION_TASK vertices per thread,
+     * the output is the same for any number of threads.
+     *
+     * @param generationThreadCount The number of threads (0 = every thread of the pool).
+     */
+    void setGenerationThreadCount(unsigned int generationThreadCount);
+
 
     // #################
     // # Other methods #
@@ -411,6 +707,52 @@ public:
      */
     void addTextureID(GLuint textureId);
 
+    /**
+     * Move the vertex buffer out of the Mesh, leaving it empty.
+     * For builders combining generated meshes without copying their buffers.
+     *
+     * @return The vertex buffer.
+     */
+    std::pmr::vector<GLfloat> takeVertexBuffer();
+
+    /**
+     * Move the element buffer out of the Mesh, leaving it empty.
+     * For builders combining generated meshes without copying their buffers.
+     *
+     * @return The element buffer.
+     */
+    std::pmr::vector<GLuint> takeElementBuffer();
+
+    /**
+     * Select the coarsest level of detail whose error covers at most maxPixelError pixels on screen.
+     *
+     * @param projectedSize The size in pixels the bounding sphere covers on screen.
+     * @param maxPixelError The largest error allowed in pixels.
+     * @return The index of the level.
+     */
+    size_t selectLOD(float projectedSize, float maxPixelError) const;
+
+    /**
+     * Draw the meshlets of a level of detail that face the camera and are inside the view frustum,
+     * merging consecutive visible meshlets into the indirect draws of a single glMultiDrawElementsIndirect.
+     * Falls back to drawElements for levels without meshlets. The Mesh's VAO must be bound.
+     *
+     * @param lod The index of the level of detail.
+     * @param modelViewProjection The transform from the vertices in the VBO to clip space.
+     * @param cameraPosition The camera position in the space of the vertices in the VBO.
+     * @param perspective True for a perspective projection, back-facing meshlets are only culled in perspective.
+     * @return The number of meshlets drawn.
+     */
+    size_t drawMeshlets(size_t lod, const glm::mat4& modelViewProjection, const glm::vec3& cameraPosition, bool perspective);
+
+    /**
+     * Draw the sub-draws of a level of detail of the Mesh as triangles.
+     * The Mesh's VAO must be bound.
+     *
+     * @param lod The index of the level of detail.
+     */
+    void drawElements(size_t lod = 0) const;
+
 
     // #############
     // # Variables #
@@ -418,15 +760,21 @@ public:
 
 
     // Class constants
-    static constexpr GLuint DEFAULT_FLOATS_PER_VERTEX = 3;
-    static constexpr GLuint DEFAULT_FLOATS_PER_COLOR = 4;
-    static constexpr GLuint DEFAULT_FLOATS_PER_NORMAL = 3;
-    static constexpr GLuint DEFAULT_FLOATS_PER_UV = 2;
+    static constexpr GLuint DEFAULT_FLOATS_PER_VERTEX = Position::COMPONENTS;
+    static constexpr GLuint DEFAULT_FLOATS_PER_COLOR = Color::COMPONENTS;
+    static constexpr GLuint DEFAULT_FLOATS_PER_NORMAL = Normal::COMPONENTS;
+    static constexpr GLuint DEFAULT_FLOATS_PER_UV = UV::COMPONENTS;
     static constexpr RotationOrder DEFAULT_ROTATION_ORDER = Z_Y_X;
     static constexpr glm::vec3 DEFAULT_SCALE_VEC3 = glm::vec3(1.0f, 1.0f, 1.0f);
     static constexpr glm::vec3 DEFAULT_ROTATION_DEGREES_VEC3 = glm::vec3(0.0f, 0.0f, 0.0f);
     static constexpr glm::vec3 DEFAULT_TRANSLATION_VEC3 = glm::vec3(0.0f, 0.0f, 0.0f);
     static constexpr glm::vec4 DEFAULT_COLOR = glm::vec4(-1.0f, -1.0f, -1.0f, -1.0f);       // No default color, will use reandom color
+    static constexpr GLuint MAX_UNSIGNED_BYTE_VERTICES = 256;       // Vertices addressable with GL_UNSIGNED_BYTE elements
+    static constexpr GLuint MAX_UNSIGNED_SHORT_VERTICES = 65536;    // Vertices addressable with GL_UNSIGNED_SHORT elements
+    static constexpr int MIN_LOD_SECTOR_COUNT = 8;                  // Fewest sectors around curved sections in a level of detail
+    static constexpr int TESSELLATION_PATCH_SECTORS = 8;            // Patches around each full turn of a tessellated Mesh
+    static constexpr size_t MESHLETS_PER_CULL_TASK = 1024;          // Meshlets culled per thread pool task
+    static constexpr size_t VERTICES_PER_GENERATION_TASK = 65536;   // Fewest vertices generated per thread pool task
 
 protected:    
     // #################
@@ -483,6 +831,235 @@ protected:
      */
     const glm::vec3 calculateNormal(const glm::vec3& vertex1, const glm::vec3& vertex2, const glm::vec3& vertex3);
 
+    /**
+     * Calculates the bounding sphere of the vertices in the vertexBuffer
+     */
+    void calculateBounds();
+
+    /**
+     * Weld and reorder the vertex and element buffers, as set up for generating the VAO.
+     *
+     * @param cacheStats Reference to store the vertex cache stats before reordering in.
+     */
+    void optimizeBuffers(VertexCacheStats& cacheStats);
+
+    /**
+     * Transform each vertex (and normal) in the vertex buffer.
+     *
+     * @param model The transformation to apply.
+     */
+    void transformVertices(const glm::mat4& model);
+
+    /**
+     * Regenerate the vertices at lower detail for each level of detail after the first,
+     * appending their elements after the full detail elements and their vertices after the full detail vertices.
+     * Transforms baked in with translateMeshPreVAO are applied to each level again.
+     */
+    void generateLODs();
+
+    /**
+     * Build the meshlets of every sub-draw of every level of detail, with their bounds moved into the space of the VBO.
+     * The element buffer must be packed first.
+     */
+    void buildMeshlets();
+
+    /**
+     * Set the detail the vertices are generated with, each level halving the sectors around curved sections
+     * down to MIN_LOD_SECTOR_COUNT.
+     *
+     * @param level The level of detail (0 = the detail the Mesh was created with).
+     * @return The largest angle between neighboring sectors at the level in radians, 0 if the Mesh has no curved sections.
+     */
+    virtual float setDetailLevel(int level);
+
+    /**
+     * Get the parameters the procedural vertex shader builds the vertices from, at the current detail level.
+     *
+     * @param geometry Reference to store the parameters in.
+     * @return True if the Mesh is a parametric shape the shader can build, false by default.
+     */
+    virtual bool getProceduralGeometry(ProceduralGeometry& geometry) const;
+
+    /**
+     * Get the sector count of a level of detail.
+     *
+     * @param sectorCount The sector count of full detail.
+     * @param level The level of detail.
+     * @return The sector count, halved per level down to MIN_LOD_SECTOR_COUNT.
+     */
+    static int getLODSectorCount(int sectorCount, int level);
+
+    /**
+     * Choose the smallest index type for the vertex count and pack the element buffer to it, level of detail by level of detail.
+     * Above 16-bit range the triangles are split into sub-draws that each span at most
+     * MAX_UNSIGNED_SHORT_VERTICES vertices, falling back to 32-bit elements if a triangle can not fit.
+     * Triangle strips are not split, and reserve the largest value of the index type for the restart index.
+     *
+     * @param packedElements Reference to store the packed elements in.
+     */
+    void packElementBuffer(std::vector<unsigned char>& packedElements);
+
+    /**
+     * Replace the triangles of each level of detail with triangle strips, unless the strips are not smaller.
+     *
+     * @return True if the element buffer holds strips.
+     */
+    bool buildTriangleStrips();
+
+    /**
+     * Generate an empty VAO and the levels of detail for vertex pulling, from the procedural geometry at each level,
+     * or the single patch grid when tessellated.
+     *
+     * @return True if the Mesh can be pulled.
+     */
+    bool generateProceduralVAO();
+
+    /**
+     * Quantize the vertex buffer into the quantized vertex format and set the dequantization.
+     * The bounding sphere is moved into the quantized space.
+     *
+     * @param quantizedVertices Reference to store the quantized vertices in.
+     * @return True if the vertices could be quantized.
+     */
+    bool quantizeVertexBuffer(std::vector<unsigned char>& quantizedVertices);
+
+    /**
+     * Resize the vertex buffer to a number of vertices of a vertex format and get a typed view of it.
+     * The format must match the Mesh's VertexMode.
+     *
+     * @param vertexCount The number of vertices.
+     * @return The vertices, aliasing the vertex buffer.
+     */
+    template <typename VertexType>
+    std::span<VertexType> resizeVertices(size_t vertexCount)
+    {
+        vertexBuffer.resize(vertexCount * VertexType::FLOATS_PER_VERTEX);
+        return std::span<VertexType>(reinterpret_cast<VertexType*>(vertexBuffer.data()), vertexCount);
+    }
+
+    /**
+     * Run a generation task over bands of rows (stacks or sectors) on the thread pool.
+     * The buffers must already be sized, and each row must only write its own vertices and elements,
+     * so the bands need no locks and the output does not depend on how the rows are split.
+     * Meshes too small to split run the task inline on the calling thread.
+     *
+     * @param rowCount The number of rows.
+     * @param verticesPerRow The number of vertices generated for each row.
+     * @param task The task to run for each band, given the band begin (inclusive) and end (exclusive) row.
+     */
+    template <typename Task>
+    void generateInBands(size_t rowCount, size_t verticesPerRow, Task task)
+    {
+        unsigned int taskCount = getGenerationTaskCount(rowCount * verticesPerRow);
+        if (taskCount <= 1) {
+            task(static_cast<size_t>(0), rowCount);
+            return;
+        }
+        runGenerationTasks(rowCount, taskCount, task);
+    }
+
+    /**
+     * Generate the vertex and element buffer of a baked shape in a vertex format, scaling its unit-size positions
+     * and clamping its UVs. The baked face normals are scaled by the cofactor of the size, the direction
+     * Mesh::calculateNormal gives for the scaled triangle, so each face only normalizes once.
+     *
+     * @tparam VertexType The vertex format matching the vertex mode.
+     * @param shape The baked shape.
+     * @param size The size of the shape along each axis.
+     */
+    template <typename VertexType, size_t VERTEX_COUNT, size_t ELEMENT_COUNT>
+    void generateBakedVertices(const BakedShape<VERTEX_COUNT, ELEMENT_COUNT>& shape, glm::vec3 size)
+    {
+        std::span<VertexType> vertices = resizeVertices<VertexType>(VERTEX_COUNT);
+        elementBuffer.assign(shape.elements.begin(), shape.elements.end());
+
+        // Same as clampU and clampV, hoisted out of the loop
+        glm::vec2 uvScale(textureUClampRatio, textureVClampRatio);
+        glm::vec2 uvOffset(textureUClamp.x, textureVClamp.x);
+
+        for (size_t i = 0; i < VERTEX_COUNT; ++i) {
+            const BakedVertex& baked = shape.vertices[i];
+            VertexType& vertex = vertices[i];
+            vertex.template set<Position>(glm::vec3(baked.x, baked.y, baked.z) * size);
+            vertex.template set<Color>(color);
+            vertex.template set<UV>(glm::vec2(baked.u, baked.v) * uvScale + uvOffset);
+        }
+
+        if constexpr (VertexType::template hasAttribute<Normal>()) {
+            glm::vec3 normalScale(size.y * size.z, size.x * size.z, size.x * size.y);
+            for (size_t i = 0; i + 2 < ELEMENT_COUNT; i += 3) {
+                const BakedVertex& baked = shape.vertices[shape.elements[i]];
+                glm::vec3 normal = glm::normalize(glm::vec3(baked.nx, baked.ny, baked.nz) * normalScale);
+                for (size_t corner = 0; corner < 3; ++corner) {
+                    vertices[shape.elements[i + corner]].template set<Normal>(normal);
+                }
+            }
+        }
+    }
+
+    /**
+     * Generate the vertex and element buffer of a parametric surface in a vertex format, in parallel bands of stacks.
+     * UVs are the slice and stack fractions clamped to the texture clamps.
+     *
+     * @tparam VertexType The vertex format matching the vertex mode.
+     * @param surface The surface to generate.
+     */
+    template <typename VertexType, typename F>
+    void generateParametricSurface(const ParametricSurface<F>& surface)
+    {
+        std::span<VertexType> vertices = resizeVertices<VertexType>(surface.getVertexCount());
+        elementBuffer.resize(surface.getElementCount());
+        std::span<GLuint> elements(elementBuffer.data(), elementBuffer.size());
+
+        // Each band of stacks writes only its own rows of vertices and the triangles after them, so bands run in parallel
+        generateInBands(surface.getStacks() + 1, surface.getSlices() + 1, [&](size_t bandBegin, size_t bandEnd) {
+            surface.template generateRows<VertexType>(vertices, elements, static_cast<int>(bandBegin), static_cast<int>(bandEnd), color, [this](glm::vec2 uv) {
+                return glm::vec2(clampU(uv.x), clampV(uv.y));
+            });
+        });
+    }
+
+    /**
+     * Get the number of bands to generate a number of vertices in.
+     *
+     * @param vertexCount The number of vertices generated.
+     * @return The number of bands, at most the generation thread count.
+     */
+    unsigned int getGenerationTaskCount(size_t vertexCount) const;
+
+    /**
+     * Split the rows into bands and run the task on each band on the thread pool.
+     *
+     * @param rowCount The number of rows.
+     * @param taskCount The number of bands.
+     * @param task The task to run for each band.
+     */
+    void runGenerationTasks(size_t rowCount, unsigned int taskCount, const std::function<void(size_t, size_t)>& task);
+
+    /**
+     * Get the key of the geometry the Mesh generates, holding the parameters every Mesh generates with
+     * (the vertex mode, the texture clamps, and the color in color modes). Types add their own parameters to it.
+     *
+     * @param type The name of the mesh type.
+     * @return The key.
+     */
+    GeometryKey getGeometryKey(const char* type) const;
+
+    /**
+     * Copy the shared geometry generated with a key into the vertex and element buffers.
+     *
+     * @param key The generation parameters.
+     * @return True if the GeometryCache had the geometry, false if it must be generated.
+     */
+    bool loadCachedGeometry(const GeometryKey& key);
+
+    /**
+     * Share the generated vertex and element buffers in the GeometryCache with other meshes generated with the same key.
+     *
+     * @param key The generation parameters.
+     */
+    void storeCachedGeometry(const GeometryKey& key);
+
 
     // ####################
     // # Abstract methods #
@@ -504,16 +1081,31 @@ protected:
 
     VertexMode vertexMode;                  // Expected mode for vertex attributes in vbo
     UnitOfMeasure unitOfMeasure;            // Unit of measure for metric to imperial scaling
-    std::vector<GLfloat> vertexBuffer;      // Store vertecies (and attributes) to create vbo with
-    std::vector<GLushort> elementBuffer;    // Store elements to create ebo with
+    std::pmr::vector<GLfloat> vertexBuffer; // Store vertecies (and attributes) to create vbo with, from the build arena for child meshes
+    std::pmr::vector<GLuint> elementBuffer; // Store elements to create ebo with, from the build arena for child meshes
+    GLenum indexType;                       // Type of the elements in the ebo
+    std::vector<SubDraw> subDraws;          // Ranges of the ebo drawn with separate draw calls
+    std::vector<MeshLOD> lods;              // Levels of detail in the ebo, full detail first
+    GLuint lodCount;                        // Number of levels of detail to generate with the VAO
+    bool cullMeshlets;                      // Build meshlets for culling when generating the VAO
+    bool triangleStrips;                    // Draw the elements as triangle strips with primitive restart
+    bool vertexPulling;                     // Build the vertices in the vertex shader instead of uploading them
+    bool tessellation;                      // Build the vertices in the tessellation shaders from a grid of patches
+    std::vector<ProceduralGeometry> proceduralLODs;             // Procedural parameters of each level of detail when pulled or tessellated
+    unsigned int generationThreadCount;     // Most threads the vertices are generated with (0 = every thread of the pool)
+    std::vector<DrawElementsIndirectCommand> meshletCommands;   // Draw command of each meshlet
+    MeshletBounds meshletBounds;            // Culling bounds of each meshlet
+    std::vector<unsigned char> meshletVisibility;               // Culling result of each meshlet, reused every draw
+    std::vector<DrawElementsIndirectCommand> visibleCommands;   // Merged draw commands of the visible meshlets, reused every draw
+    GLuint indirectBuffer;                  // Draw Indirect Buffer Object for the visible meshlets
     GLuint floatsPerVertex;                 // The number of values per vertex attribute
     GLuint floatsPerColor;                  // The number of values per color attribute
     GLuint floatsPerNormal;                 // The number of values per Normal attribute
     GLuint floatsPerUV;                     // The number of values per UV attribute
     GLuint stride;                          // Number of floats between vertecies
-    GLuint vbo;                             // Vertex Buffer Object
-    GLuint ebo;                             // Element (Index) Buffer Object
-    GLuint vao;                             // Vertex Array Object
+    GLuint vbo{0};                          // Vertex Buffer Object (0 = none, pulled meshes have no buffers)
+    GLuint ebo{0};                          // Element (Index) Buffer Object (0 = none)
+    GLuint vao{0};                          // Vertex Array Object
     glm::mat4 scale;                        // The scale matrix for the mesh
     glm::mat4 rotation;                     // The rotation matrix for the mesh
     glm::mat4 translation;                  // The translation matrix for the mesh
@@ -524,4 +1116,14 @@ protected:
     GLfloat textureUClampRatio;             // Ratio of clamp for texture U coordnitate clamping
     GLfloat textureVClampRatio;             // Ratio of clamp for texture U coordnitate clamping
     glm::vec4 color;                        // The color to use when rendering with a color mode
+    bool quantizeVertices;                  // Quantize the vertices when generating the VAO
+    float weldEpsilon;                      // Tolerance for welding duplicate vertices (negative = no welding)
+    GLsizei unweldedVertexCount;            // Number of vertices before welding
+    bool optimizeVertexOrder;               // Reorder the triangles and vertices when generating the VAO
+    VertexCacheStats unoptimizedCacheStats; // Vertex cache stats of the generated element order
+    VertexCacheStats optimizedCacheStats;   // Vertex cache stats of the uploaded element order
+    glm::mat4 preVAOTransform;              // Transforms baked into the vertices by translateMeshPreVAO
+    glm::mat4 dequantization;               // Transform from quantized positions to object space
+    glm::vec3 boundingCenter;               // Center of the bounding sphere of the vertices
+    float boundingRadius;                   // Radius of the bounding sphere of the vertices
 };
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "MeshBuildArena.h"
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// ################
+// # Constructors #
+// ################
+
+
+MeshBuildArena::Scope::Scope()
+{
+    MeshBuildArena::getInstance().beginScope();
+}
+
+MeshBuildArena::Scope::~Scope()
+{
+    MeshBuildArena::getInstance().endScope();
+}
+
+
+// ######################
+// # Singleton Instance #
+// ######################
+
+
+MeshBuildArena& MeshBuildArena::getInstance()
+{
+    thread_local MeshBuildArena instance;
+    return instance;
+}
+
+
+// ##################
+// # Getter methods #
+// ##################
+
+
+std::pmr::memory_resource* MeshBuildArena::getResource()
+{
+    return active ? &*arena : std::pmr::get_default_resource();
+}
+
+const bool MeshBuildArena::getEnabled() const
+{
+    return enabled;
+}
+
+const size_t MeshBuildArena::getCapacity() const
+{
+    return capacity;
+}
+
+
+// ##################
+// # Setter methods #
+// ##################
+
+
+void MeshBuildArena::setEnabled(bool enabled)
+{
+    this->enabled = enabled;
+}
+
+
+// ###################
+// #                 #
+// # Private methods #
+// #                 #
+// ###################
+
+
+// ################
+// # Constructors #
+// ################
+
+
+MeshBuildArena::MeshBuildArena()
+    : enabled(true), active(false), scopeDepth(0), capacity(0)
+{
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+void MeshBuildArena::beginScope()
+{
+    if (scopeDepth++ > 0 || !enabled) {
+        return;
+    }
+
+    if (!arena) {
+        capacity = INITIAL_CAPACITY;
+        buffer = std::make_unique_for_overwrite<std::byte[]>(capacity);
+        arena.emplace(buffer.get(), capacity, &overflow);
+    }
+    active = true;
+}
+
+void MeshBuildArena::endScope()
+{
+    if (--scopeDepth > 0 || !active) {
+        return;
+    }
+    active = false;
+
+    // Everything from the build has been freed, hand the whole buffer out again next build
+    arena.reset();
+    if (overflow.bytes > 0) {
+        capacity += overflow.bytes;
+        buffer = std::make_unique_for_overwrite<std::byte[]>(capacity);
+        overflow.bytes = 0;
+    }
+    arena.emplace(buffer.get(), capacity, &overflow);
+}
+
+void* MeshBuildArena::OverflowResource::do_allocate(size_t bytes, size_t alignment)
+{
+    this->bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void MeshBuildArena::OverflowResource::do_deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+}
+
+bool MeshBuildArena::OverflowResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
@@ -0,0 +1,161 @@
+// MeshBuildArena.h
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+/**
+ * Class representing the monotonic arena the buffers of temporary child meshes are allocated from while a
+ * composite mesh is built. Meshes constructed while a Scope is open allocate their vertex and element buffers
+ * from the arena, and the arena is reset when the outermost Scope closes. Memory is kept between builds and
+ * grows to the largest build, so repeated builds stop allocating from the heap.
+ * Meshes constructed inside a Scope must not outlive it. Each thread has its own arena.
+ */
+class MeshBuildArena {
+public:
+    /**
+     * Class representing a build of a composite mesh, meshes constructed while it is alive use the arena.
+     * Scopes nest, only the outermost resets the arena.
+     */
+    class Scope {
+    public:
+        /**
+         * Scope constructor.
+         * Opens a build on the arena of the calling thread.
+         */
+        Scope();
+
+        /**
+         * Scope destructor.
+         * Closes the build, resetting the arena if it was the outermost.
+         */
+        ~Scope();
+
+        // Prevent copying and assignment
+        Scope(const Scope&) = delete;
+        void operator=(const Scope&) = delete;
+    };
+
+
+    // ######################
+    // # Singleton Instance #
+    // ######################
+
+
+    /**
+     * Get the Mesh Build Arena Singleton Instance of the calling thread
+     */
+    static MeshBuildArena& getInstance();
+
+    // Prevent copying and assignment
+    MeshBuildArena(const MeshBuildArena&) = delete;
+    void operator=(const MeshBuildArena&) = delete;
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the memory resource for mesh buffers constructed now.
+     *
+     * @return The arena while a build is open, otherwise the default memory resource.
+     */
+    std::pmr::memory_resource* getResource();
+
+    /**
+     * Check if builds use the arena.
+     *
+     * @return True if the arena is enabled.
+     */
+    const bool getEnabled() const;
+
+    /**
+     * Get the size of the buffer the arena hands out before falling back to the heap.
+     *
+     * @return The capacity in bytes.
+     */
+    const size_t getCapacity() const;
+
+
+    // ##################
+    // # Setter methods #
+    // ##################
+
+
+    /**
+     * Set if builds use the arena, taking effect from the next outermost Scope.
+     *
+     * @param enabled True to allocate child mesh buffers from the arena, false to use the heap.
+     */
+    void setEnabled(bool enabled);
+
+
+    // #############
+    // # Variables #
+    // #############
+
+
+    // Class constants
+    static constexpr size_t INITIAL_CAPACITY = 256 * 1024;  // Bytes reserved by the first build
+
+private:
+    /**
+     * Class representing the heap behind the arena, counting the bytes the arena needed past its buffer.
+     */
+    class OverflowResource : public std::pmr::memory_resource {
+    public:
+        size_t bytes = 0;               // Bytes allocated since the arena was last reset
+
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * MeshBuildArena constructor.
+     * The buffer is not reserved until the first build.
+     */
+    MeshBuildArena();
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Open a build, starting to use the arena if it is the outermost.
+     */
+    void beginScope();
+
+    /**
+     * Close a build, resetting the arena if it was the outermost.
+     * The buffer grows by the bytes that overflowed to the heap, so the next build fits.
+     */
+    void endScope();
+
+
+    // #############
+    // # Variables #
+    // #############
+
+
+    bool enabled;                               // Builds use the arena
+    bool active;                                // The outermost open build is using the arena
+    int scopeDepth;                             // Number of open builds
+    std::unique_ptr<std::byte[]> buffer;        // Memory handed out before overflowing
+    size_t capacity;                            // Size of the buffer in bytes
+    OverflowResource overflow;                  // Heap used once the buffer is exhausted
+    std::optional<std::pmr::monotonic_buffer_resource> arena;  // Bump allocator over the buffer
+};
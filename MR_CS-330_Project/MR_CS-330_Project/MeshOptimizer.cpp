@@ -0,0 +1,601 @@
+#include "MeshOptimizer.h"
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Unnamed namespace
+namespace
+{
+    // Forsyth vertex score tuning
+    const float CACHE_DECAY_POWER = 1.5f;
+    const float LAST_TRIANGLE_SCORE = 0.75f;
+    const float VALENCE_BOOST_SCALE = 2.0f;
+    const float VALENCE_BOOST_POWER = 0.5f;
+
+    /**
+     * Score a vertex by its LRU cache position and how many triangles still use it.
+     */
+    float getVertexScore(int cachePosition, GLuint remainingTriangles)
+    {
+        if (remainingTriangles == 0) {
+            return -1.0f;
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // The last triangle's vertices score lower so the next triangle does not just turn back
+                score = LAST_TRIANGLE_SCORE;
+            }
+            else {
+                float scaler = 1.0f / (MeshOptimizer::FORSYTH_CACHE_SIZE - 3);
+                score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+            }
+        }
+
+        // Vertices with few triangles left are finished first so they stop occupying the cache
+        return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+    }
+}
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// #################
+// # Other methods #
+// #################
+
+
+size_t MeshOptimizer::weldVertices(std::pmr::vector<GLfloat>& vertexBuffer, std::pmr::vector<GLuint>& elementBuffer, GLuint floatsPerVertex, float epsilon)
+{
+    size_t vertexCount = vertexBuffer.size() / floatsPerVertex;
+    if (vertexCount == 0) {
+        return 0;
+    }
+
+    // Compare the bits of the values snapped to the tolerance, so equal keys hash equally
+    std::vector<uint32_t> keys(vertexCount * floatsPerVertex);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        float value = (epsilon > 0.0f) ? std::round(vertexBuffer[i] / epsilon) : vertexBuffer[i];
+        if (value == 0.0f) {
+            value = 0.0f;   // -0.0 matches 0.0
+        }
+        std::memcpy(&keys[i], &value, sizeof(value));
+    }
+
+    // Open addressing table of the first vertex of each unique key, at most half full
+    size_t tableSize = 1;
+    while (tableSize < vertexCount * 2) {
+        tableSize <<= 1;
+    }
+    const GLuint EMPTY_SLOT = 0xFFFFFFFF;
+    std::vector<GLuint> table(tableSize, EMPTY_SLOT);
+    std::vector<GLuint> remap(vertexCount);
+    size_t uniqueCount = 0;
+
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        const uint32_t* vertexKey = &keys[vertex * floatsPerVertex];
+
+        // FNV-1a over the vertex key
+        uint32_t hash = 2166136261u;
+        for (GLuint i = 0; i < floatsPerVertex; ++i) {
+            hash = (hash ^ vertexKey[i]) * 16777619u;
+        }
+
+        size_t slot = hash & (tableSize - 1);
+        while (table[slot] != EMPTY_SLOT && std::memcmp(&keys[table[slot] * floatsPerVertex], vertexKey, floatsPerVertex * sizeof(uint32_t)) != 0) {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        if (table[slot] != EMPTY_SLOT) {
+            remap[vertex] = remap[table[slot]];
+            continue;
+        }
+
+        // First occurrence, compact it down to the next unique position
+        table[slot] = static_cast<GLuint>(vertex);
+        remap[vertex] = static_cast<GLuint>(uniqueCount);
+        if (uniqueCount != vertex) {
+            std::memcpy(&vertexBuffer[uniqueCount * floatsPerVertex], &vertexBuffer[vertex * floatsPerVertex], floatsPerVertex * sizeof(GLfloat));
+        }
+        ++uniqueCount;
+    }
+
+    vertexBuffer.resize(uniqueCount * floatsPerVertex);
+    for (GLuint& element : elementBuffer) {
+        element = remap[element];
+    }
+
+    return vertexCount - uniqueCount;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::pmr::vector<GLuint>& elementBuffer, size_t vertexCount)
+{
+    size_t triangleCount = elementBuffer.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Triangles of each vertex, packed by vertex
+    std::vector<GLuint> triangleOffsets(vertexCount + 1, 0);
+    for (GLuint element : elementBuffer) {
+        ++triangleOffsets[element + 1];
+    }
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        triangleOffsets[vertex + 1] += triangleOffsets[vertex];
+    }
+    std::vector<GLuint> vertexTriangles(elementBuffer.size());
+    std::vector<GLuint> remainingTriangles(vertexCount, 0);
+    for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        for (int corner = 0; corner < 3; ++corner) {
+            GLuint vertex = elementBuffer[triangle * 3 + corner];
+            vertexTriangles[triangleOffsets[vertex] + remainingTriangles[vertex]++] = static_cast<GLuint>(triangle);
+        }
+    }
+
+    std::vector<int> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; ++vertex) {
+        vertexScores[vertex] = getVertexScore(-1, remainingTriangles[vertex]);
+    }
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool> emitted(triangleCount, false);
+    for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        triangleScores[triangle] = vertexScores[elementBuffer[triangle * 3]] + vertexScores[elementBuffer[triangle * 3 + 1]] + vertexScores[elementBuffer[triangle * 3 + 2]];
+    }
+
+    // LRU cache, with room for the 3 vertices pushed past the end by each emitted triangle
+    std::vector<GLuint> cache;
+    std::vector<GLuint> nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+    std::pmr::vector<GLuint> optimized(elementBuffer.get_allocator());
+    optimized.reserve(elementBuffer.size());
+    size_t bestTriangle = 0;
+    size_t scanPosition = 0;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        // Once the cache has nothing left to offer, restart from the first triangle still waiting
+        if (emitted[bestTriangle]) {
+            while (emitted[scanPosition]) {
+                ++scanPosition;
+            }
+            bestTriangle = scanPosition;
+        }
+
+        emitted[bestTriangle] = true;
+        const GLuint* triangleVertices = &elementBuffer[bestTriangle * 3];
+        nextCache.assign(triangleVertices, triangleVertices + 3);
+
+        for (int corner = 0; corner < 3; ++corner) {
+            GLuint vertex = triangleVertices[corner];
+            optimized.push_back(vertex);
+
+            // Drop the triangle from the vertex's remaining triangles
+            GLuint* first = &vertexTriangles[triangleOffsets[vertex]];
+            GLuint* last = first + remainingTriangles[vertex];
+            *std::find(first, last, static_cast<GLuint>(bestTriangle)) = *(last - 1);
+            --remainingTriangles[vertex];
+        }
+
+        for (GLuint vertex : cache) {
+            if (vertex != triangleVertices[0] && vertex != triangleVertices[1] && vertex != triangleVertices[2]) {
+                nextCache.push_back(vertex);
+            }
+        }
+        std::swap(cache, nextCache);
+
+        // Rescore the cached vertices, then the triangles touching them to pick the next triangle
+        for (size_t position = 0; position < cache.size(); ++position) {
+            GLuint vertex = cache[position];
+            cachePositions[vertex] = (position < FORSYTH_CACHE_SIZE) ? static_cast<int>(position) : -1;
+            float scoreChange = getVertexScore(cachePositions[vertex], remainingTriangles[vertex]) - vertexScores[vertex];
+            vertexScores[vertex] += scoreChange;
+
+            for (GLuint i = 0; i < remainingTriangles[vertex]; ++i) {
+                triangleScores[vertexTriangles[triangleOffsets[vertex] + i]] += scoreChange;
+            }
+        }
+
+        float bestScore = -1.0f;
+        for (GLuint vertex : cache) {
+            for (GLuint i = 0; i < remainingTriangles[vertex]; ++i) {
+                GLuint triangle = vertexTriangles[triangleOffsets[vertex] + i];
+                if (triangleScores[triangle] > bestScore) {
+                    bestScore = triangleScores[triangle];
+                    bestTriangle = triangle;
+                }
+            }
+        }
+
+        if (cache.size() > FORSYTH_CACHE_SIZE) {
+            cache.resize(FORSYTH_CACHE_SIZE);
+        }
+    }
+
+    elementBuffer = std::move(optimized);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::pmr::vector<GLuint>& elementBuffer, std::span<const GLfloat> vertexBuffer, GLuint floatsPerVertex, GLint normalOffset)
+{
+    size_t triangleCount = elementBuffer.size() / 3;
+    size_t vertexCount = vertexBuffer.size() / floatsPerVertex;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    auto getPosition = [&](GLuint vertex) {
+        return glm::vec3(vertexBuffer[vertex * floatsPerVertex], vertexBuffer[vertex * floatsPerVertex + 1], vertexBuffer[vertex * floatsPerVertex + 2]);
+    };
+
+    // FIFO cache simulation of one triangle, returns its vertex cache misses
+    std::vector<size_t> cacheTimes(vertexCount, 0);
+    size_t time = SIMULATED_CACHE_SIZE + 1;
+    auto simulateTriangle = [&](size_t triangle) {
+        int misses = 0;
+        for (int corner = 0; corner < 3; ++corner) {
+            GLuint vertex = elementBuffer[triangle * 3 + corner];
+            if (time - cacheTimes[vertex] > SIMULATED_CACHE_SIZE) {
+                cacheTimes[vertex] = time++;
+                ++misses;
+            }
+        }
+        return misses;
+    };
+    auto flushCache = [&]() { time += SIMULATED_CACHE_SIZE + 1; };
+
+    // Hard boundaries where the cache order restarts, a triangle missing the cache on every vertex
+    std::vector<size_t> hardStarts;
+    for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        if (simulateTriangle(triangle) == 3 || triangle == 0) {
+            hardStarts.push_back(triangle);
+        }
+    }
+    hardStarts.push_back(triangleCount);
+
+    // Soft boundaries inside each hard cluster, wherever the cache has warmed up enough that starting cold
+    // again keeps the cluster ACMR within the threshold
+    std::vector<size_t> clusterStarts;
+    for (size_t hard = 0; hard + 1 < hardStarts.size(); ++hard) {
+        size_t start = hardStarts[hard];
+        size_t end = hardStarts[hard + 1];
+
+        flushCache();
+        size_t hardMisses = 0;
+        for (size_t triangle = start; triangle < end; ++triangle) {
+            hardMisses += simulateTriangle(triangle);
+        }
+        float threshold = OVERDRAW_ACMR_THRESHOLD * hardMisses / (end - start);
+
+        flushCache();
+        clusterStarts.push_back(start);
+        size_t softStart = start;
+        size_t softMisses = 0;
+        for (size_t triangle = start; triangle < end; ++triangle) {
+            softMisses += simulateTriangle(triangle);
+            if (triangle + 1 < end && static_cast<float>(softMisses) / (triangle + 1 - softStart) <= threshold) {
+                clusterStarts.push_back(triangle + 1);
+                softStart = triangle + 1;
+                softMisses = 0;
+                flushCache();
+            }
+        }
+    }
+    clusterStarts.push_back(triangleCount);
+
+    // Area weighted centroid of the mesh, and of each cluster with its average normal
+    std::vector<glm::vec3> clusterCentroids(clusterStarts.size() - 1);
+    std::vector<glm::vec3> clusterNormals(clusterStarts.size() - 1);
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+
+    for (size_t cluster = 0; cluster + 1 < clusterStarts.size(); ++cluster) {
+        glm::vec3 centroid(0.0f);
+        glm::vec3 normal(0.0f);
+        float clusterArea = 0.0f;
+
+        for (size_t triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; ++triangle) {
+            glm::vec3 a = getPosition(elementBuffer[triangle * 3]);
+            glm::vec3 b = getPosition(elementBuffer[triangle * 3 + 1]);
+            glm::vec3 c = getPosition(elementBuffer[triangle * 3 + 2]);
+            glm::vec3 areaNormal = glm::cross(b - a, c - a);
+            float area = glm::length(areaNormal);
+
+            // Flip triangles wound against their vertex normals, so opposite windings do not cancel in the cluster
+            if (normalOffset >= 0) {
+                glm::vec3 vertexNormal(0.0f);
+                for (int corner = 0; corner < 3; ++corner) {
+                    const GLfloat* values = &vertexBuffer[elementBuffer[triangle * 3 + corner] * floatsPerVertex + normalOffset];
+                    vertexNormal += glm::vec3(values[0], values[1], values[2]);
+                }
+                if (glm::dot(areaNormal, vertexNormal) < 0.0f) {
+                    areaNormal = -areaNormal;
+                }
+            }
+
+            centroid += (a + b + c) / 3.0f * area;
+            normal += areaNormal;
+            clusterArea += area;
+        }
+
+        meshCentroid += centroid;
+        meshArea += clusterArea;
+        clusterCentroids[cluster] = (clusterArea > 0.0f) ? centroid / clusterArea : getPosition(elementBuffer[clusterStarts[cluster] * 3]);
+        clusterNormals[cluster] = normal;
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    // Clusters facing out from the center occlude the rest of the mesh from most views, so draw them first
+    std::vector<float> sortKeys(clusterCentroids.size());
+    std::vector<size_t> clusterOrder(clusterCentroids.size());
+    for (size_t cluster = 0; cluster < clusterCentroids.size(); ++cluster) {
+        float normalLength = glm::length(clusterNormals[cluster]);
+        sortKeys[cluster] = (normalLength > 0.0f) ? glm::dot(clusterCentroids[cluster] - meshCentroid, clusterNormals[cluster] / normalLength) : 0.0f;
+        clusterOrder[cluster] = cluster;
+    }
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    std::pmr::vector<GLuint> sorted(elementBuffer.get_allocator());
+    sorted.reserve(elementBuffer.size());
+    for (size_t cluster : clusterOrder) {
+        sorted.insert(sorted.end(), elementBuffer.begin() + clusterStarts[cluster] * 3, elementBuffer.begin() + clusterStarts[cluster + 1] * 3);
+    }
+
+    elementBuffer = std::move(sorted);
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::pmr::vector<GLfloat>& vertexBuffer, std::pmr::vector<GLuint>& elementBuffer, GLuint floatsPerVertex)
+{
+    size_t vertexCount = vertexBuffer.size() / floatsPerVertex;
+    const GLuint UNUSED_VERTEX = 0xFFFFFFFF;
+    std::vector<GLuint> remap(vertexCount, UNUSED_VERTEX);
+    std::pmr::vector<GLfloat> reordered(vertexBuffer.get_allocator());
+    reordered.reserve(vertexBuffer.size());
+
+    // Vertices move to the order the elements first use them, unused vertices are dropped
+    GLuint nextVertex = 0;
+    for (GLuint& element : elementBuffer) {
+        if (remap[element] == UNUSED_VERTEX) {
+            remap[element] = nextVertex++;
+            reordered.insert(reordered.end(), vertexBuffer.begin() + element * floatsPerVertex, vertexBuffer.begin() + (element + 1) * floatsPerVertex);
+        }
+        element = remap[element];
+    }
+
+    vertexBuffer = std::move(reordered);
+}
+
+std::vector<Meshlet> MeshOptimizer::buildMeshlets(std::span<const GLuint> elements, std::span<const GLfloat> vertexBuffer, GLuint floatsPerVertex, GLint normalOffset)
+{
+    std::vector<Meshlet> meshlets;
+    size_t vertexCount = vertexBuffer.size() / floatsPerVertex;
+    const GLuint NO_MESHLET = 0xFFFFFFFF;
+    std::vector<GLuint> vertexMeshlets(vertexCount, NO_MESHLET);
+    std::vector<GLuint> meshletVertices;
+    meshletVertices.reserve(MAX_MESHLET_VERTICES);
+
+    auto getPosition = [&](GLuint vertex) {
+        return glm::vec3(vertexBuffer[vertex * floatsPerVertex], vertexBuffer[vertex * floatsPerVertex + 1], vertexBuffer[vertex * floatsPerVertex + 2]);
+    };
+
+    // Bounding sphere around the vertex centroid and the normal cone of the triangles
+    auto finishMeshlet = [&](GLuint firstElement, GLuint endElement) {
+        Meshlet meshlet = { firstElement, endElement - firstElement, glm::vec3(0.0f), 0.0f, glm::vec3(0.0f), 1.0f };
+
+        for (GLuint vertex : meshletVertices) {
+            meshlet.center += getPosition(vertex);
+        }
+        meshlet.center /= static_cast<float>(meshletVertices.size());
+        for (GLuint vertex : meshletVertices) {
+            meshlet.radius = std::max(meshlet.radius, glm::length(getPosition(vertex) - meshlet.center));
+        }
+
+        std::vector<glm::vec3> facings;
+        facings.reserve(meshlet.elementCount / 3);
+        for (GLuint element = firstElement; element + 2 < endElement; element += 3) {
+            glm::vec3 a = getPosition(elements[element]);
+            glm::vec3 facing = glm::cross(getPosition(elements[element + 1]) - a, getPosition(elements[element + 2]) - a);
+            float length = glm::length(facing);
+            if (length <= 0.0f) {
+                continue;   // Degenerate triangles can not be seen from either side
+            }
+            facing /= length;
+
+            if (normalOffset >= 0) {
+                glm::vec3 normal(0.0f);
+                for (int corner = 0; corner < 3; ++corner) {
+                    const GLfloat* values = &vertexBuffer[elements[element + corner] * floatsPerVertex + normalOffset];
+                    normal += glm::vec3(values[0], values[1], values[2]);
+                }
+                if (glm::dot(facing, normal) < 0.0f) {
+                    facing = -facing;
+                }
+            }
+
+            facings.push_back(facing);
+            meshlet.coneAxis += facing;
+        }
+
+        float axisLength = glm::length(meshlet.coneAxis);
+        if (normalOffset >= 0 && axisLength > 0.0f) {
+            meshlet.coneAxis /= axisLength;
+
+            float minimumDot = 1.0f;
+            for (const glm::vec3& facing : facings) {
+                minimumDot = std::min(minimumDot, glm::dot(facing, meshlet.coneAxis));
+            }
+
+            // Past 90 degrees some triangle faces every viewer, keep the cutoff at 1 so it is never culled
+            if (minimumDot > 0.0f) {
+                meshlet.coneCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+            }
+        }
+        else {
+            meshlet.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+        }
+
+        meshlets.push_back(meshlet);
+        meshletVertices.clear();
+    };
+
+    GLuint firstElement = 0;
+    for (GLuint element = 0; element + 2 < elements.size(); element += 3) {
+        GLuint meshletIndex = static_cast<GLuint>(meshlets.size());
+        GLuint newVertices = 0;
+        for (int corner = 0; corner < 3; ++corner) {
+            GLuint vertex = elements[element + corner];
+            bool repeated = (corner > 0 && vertex == elements[element]) || (corner > 1 && vertex == elements[element + 1]);
+            if (vertexMeshlets[vertex] != meshletIndex && !repeated) {
+                ++newVertices;
+            }
+        }
+
+        GLuint triangleCount = (element - firstElement) / 3;
+        if (triangleCount > 0 && (meshletVertices.size() + newVertices > MAX_MESHLET_VERTICES || triangleCount + 1 > MAX_MESHLET_TRIANGLES)) {
+            finishMeshlet(firstElement, element);
+            firstElement = element;
+            ++meshletIndex;
+        }
+
+        for (int corner = 0; corner < 3; ++corner) {
+            GLuint vertex = elements[element + corner];
+            if (vertexMeshlets[vertex] != meshletIndex) {
+                vertexMeshlets[vertex] = meshletIndex;
+                meshletVertices.push_back(vertex);
+            }
+        }
+    }
+    if (firstElement + 2 < elements.size()) {
+        finishMeshlet(firstElement, static_cast<GLuint>(elements.size() / 3 * 3));
+    }
+
+    return meshlets;
+}
+
+void MeshOptimizer::stripifyTriangles(std::span<const GLuint> triangles, std::pmr::vector<GLuint>& strips)
+{
+    size_t triangleCount = triangles.size() / 3;
+    const size_t NO_TRIANGLE = SIZE_MAX;
+
+    // Every edge of every triangle, sorted by the edge so the triangles across an edge are a binary search away
+    struct TriangleEdge {
+        uint64_t edge;
+        size_t triangle;
+    };
+    auto getEdge = [](GLuint a, GLuint b) {
+        return (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+    };
+    std::vector<TriangleEdge> edges;
+    edges.reserve(triangleCount * 3);
+    std::vector<bool> used(triangleCount, false);
+    for (size_t triangle = 0; triangle < triangleCount; ++triangle) {
+        const GLuint* corners = triangles.data() + triangle * 3;
+        if (corners[0] == corners[1] || corners[1] == corners[2] || corners[2] == corners[0]) {
+            used[triangle] = true;
+            continue;
+        }
+        for (int corner = 0; corner < 3; ++corner) {
+            edges.push_back({ getEdge(corners[corner], corners[(corner + 1) % 3]), triangle });
+        }
+    }
+    std::sort(edges.begin(), edges.end(), [](const TriangleEdge& left, const TriangleEdge& right) {
+        return left.edge < right.edge || (left.edge == right.edge && left.triangle < right.triangle);
+    });
+
+    auto findNeighbor = [&](GLuint a, GLuint b) {
+        uint64_t edge = getEdge(a, b);
+        auto it = std::lower_bound(edges.begin(), edges.end(), edge, [](const TriangleEdge& triangleEdge, uint64_t value) {
+            return triangleEdge.edge < value;
+        });
+        for (; it != edges.end() && it->edge == edge; ++it) {
+            if (!used[it->triangle]) {
+                return it->triangle;
+            }
+        }
+        return NO_TRIANGLE;
+    };
+
+    // Grow a strip from a starting triangle, marking its triangles used, and return the elements after the first 3
+    std::vector<GLuint> strip;
+    std::vector<size_t> stripTriangles;
+    auto walkStrip = [&](GLuint b, GLuint c) {
+        strip.clear();
+        stripTriangles.clear();
+        for (size_t next = findNeighbor(b, c); next != NO_TRIANGLE; next = findNeighbor(b, c)) {
+            const GLuint* corners = triangles.data() + next * 3;
+            GLuint d = (corners[0] != b && corners[0] != c) ? corners[0] : (corners[1] != b && corners[1] != c) ? corners[1] : corners[2];
+            used[next] = true;
+            stripTriangles.push_back(next);
+            strip.push_back(d);
+            b = c;
+            c = d;
+        }
+    };
+
+    bool firstStrip = true;
+    for (size_t start = 0; start < triangleCount; ++start) {
+        if (used[start]) {
+            continue;
+        }
+        used[start] = true;
+
+        // Which edge the strip leaves the first triangle by decides how far it runs, so the longest of the 3 is kept
+        const GLuint* corners = triangles.data() + start * 3;
+        int bestRotation = 0;
+        size_t bestLength = 0;
+        for (int rotation = 0; rotation < 3; ++rotation) {
+            walkStrip(corners[(rotation + 1) % 3], corners[(rotation + 2) % 3]);
+            for (size_t triangle : stripTriangles) {
+                used[triangle] = false;
+            }
+            if (strip.size() > bestLength) {
+                bestLength = strip.size();
+                bestRotation = rotation;
+            }
+        }
+
+        if (!firstStrip) {
+            strips.push_back(STRIP_RESTART_INDEX);
+        }
+        firstStrip = false;
+        strips.push_back(corners[bestRotation]);
+        strips.push_back(corners[(bestRotation + 1) % 3]);
+        strips.push_back(corners[(bestRotation + 2) % 3]);
+        walkStrip(corners[(bestRotation + 1) % 3], corners[(bestRotation + 2) % 3]);
+        strips.insert(strips.end(), strip.begin(), strip.end());
+    }
+}
+
+VertexCacheStats MeshOptimizer::analyzeVertexCache(std::span<const GLuint> elementBuffer, size_t vertexCount, GLuint cacheSize)
+{
+    VertexCacheStats stats;
+    stats.triangleCount = elementBuffer.size() / 3;
+
+    // FIFO cache, a vertex is cached while fewer than cacheSize vertices were transformed after it
+    std::vector<size_t> cacheTimes(vertexCount, 0);
+    std::vector<bool> referenced(vertexCount, false);
+    size_t time = cacheSize + 1;
+    for (GLuint element : elementBuffer) {
+        if (time - cacheTimes[element] > cacheSize) {
+            cacheTimes[element] = time++;
+            ++stats.transformedCount;
+        }
+        if (!referenced[element]) {
+            referenced[element] = true;
+            ++stats.vertexCount;
+        }
+    }
+
+    return stats;
+}
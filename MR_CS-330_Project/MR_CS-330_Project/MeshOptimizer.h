@@ -0,0 +1,150 @@
+// MeshOptimizer.h
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+/**
+ * Struct representing how well an element order uses the post-transform vertex cache.
+ */
+struct VertexCacheStats {
+    size_t triangleCount = 0;           // Number of triangles drawn
+    size_t vertexCount = 0;             // Number of unique vertices referenced
+    size_t transformedCount = 0;        // Number of vertex shader invocations (cache misses)
+
+    /**
+     * Get the average cache miss ratio, vertices transformed per triangle (0.5 is ideal, 3 is worst).
+     *
+     * @return The ACMR.
+     */
+    float getACMR() const { return triangleCount ? static_cast<float>(transformedCount) / triangleCount : 0.0f; }
+
+    /**
+     * Get the average transform to vertex ratio, vertices transformed per unique vertex (1 is ideal).
+     *
+     * @return The ATVR.
+     */
+    float getATVR() const { return vertexCount ? static_cast<float>(transformedCount) / vertexCount : 0.0f; }
+};
+
+/**
+ * Struct representing a cluster of triangles from a contiguous range of elements, with the bounds it is culled by.
+ */
+struct Meshlet {
+    GLuint firstElement;                // Index of the first element of the cluster in the elements it was built from
+    GLuint elementCount;                // Number of elements in the cluster
+    glm::vec3 center;                   // Center of the bounding sphere of the cluster
+    float radius;                       // Radius of the bounding sphere of the cluster
+    glm::vec3 coneAxis;                 // Average facing direction of the triangles
+    float coneCutoff;                   // Sine of the widest angle between the axis and a triangle facing (1 = never back-facing)
+};
+
+/**
+ * Class representing the optimization passes run on generated vertex and element buffers before upload.
+ */
+class MeshOptimizer {
+public:
+    // Prevent construction, the passes hold no state
+    MeshOptimizer() = delete;
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Merge duplicate vertices and rebuild the element buffer to reference the unique vertices.
+     * Vertices match when every attribute value is equal, or rounds to the same multiple of epsilon.
+     * Unique vertices keep the order (and values) of their first occurrence.
+     *
+     * @param vertexBuffer The interleaved vertices to weld.
+     * @param elementBuffer The elements to remap.
+     * @param floatsPerVertex The number of floats in each vertex (all attributes).
+     * @param epsilon The matching tolerance (0 = exact matching).
+     * @return The number of vertices removed.
+     */
+    static size_t weldVertices(std::pmr::vector<GLfloat>& vertexBuffer, std::pmr::vector<GLuint>& elementBuffer, GLuint floatsPerVertex, float epsilon = 0.0f);
+
+    /**
+     * Reorder triangles so consecutive triangles reuse vertices in the post-transform vertex cache
+     * (Forsyth's linear-speed vertex cache optimization).
+     *
+     * @param elementBuffer The triangle elements to reorder.
+     * @param vertexCount The number of vertices the elements reference.
+     */
+    static void optimizeVertexCache(std::pmr::vector<GLuint>& elementBuffer, size_t vertexCount);
+
+    /**
+     * Reorder clusters of triangles to reduce overdraw from any view, keeping the vertex cache order inside clusters.
+     * Clusters split where the cache order restarts or the ACMR allows, and are drawn outward facing first (Sander et al.).
+     * Triangle facing follows the vertex normals when there are any, since the generators do not wind triangles consistently.
+     *
+     * @param elementBuffer The triangle elements to reorder, already optimized for the vertex cache.
+     * @param vertexBuffer The interleaved vertices, starting with the position.
+     * @param floatsPerVertex The number of floats in each vertex (all attributes).
+     * @param normalOffset The offset in floats of the normal in each vertex (-1 = no normals, facing follows the winding).
+     */
+    static void optimizeOverdraw(std::pmr::vector<GLuint>& elementBuffer, std::span<const GLfloat> vertexBuffer, GLuint floatsPerVertex, GLint normalOffset);
+
+    /**
+     * Reorder vertices into the order the elements first reference them, for pre-transform fetch locality.
+     *
+     * @param vertexBuffer The interleaved vertices to reorder.
+     * @param elementBuffer The elements to remap.
+     * @param floatsPerVertex The number of floats in each vertex (all attributes).
+     */
+    static void optimizeVertexFetch(std::pmr::vector<GLfloat>& vertexBuffer, std::pmr::vector<GLuint>& elementBuffer, GLuint floatsPerVertex);
+
+    /**
+     * Split triangle elements into meshlets of at most MAX_MESHLET_VERTICES vertices and MAX_MESHLET_TRIANGLES triangles.
+     * Meshlets are consecutive runs of the element order, so the elements should be optimized for the vertex cache first.
+     * Triangle facing follows the vertex normals when there are any, since the generators do not wind triangles consistently.
+     *
+     * @param elements The triangle elements to split.
+     * @param vertexBuffer The interleaved vertices, starting with the position.
+     * @param floatsPerVertex The number of floats in each vertex (all attributes).
+     * @param normalOffset The offset in floats of the normal in each vertex (-1 = no normals, meshlets are never back-facing).
+     * @return The meshlets, in element order.
+     */
+    static std::vector<Meshlet> buildMeshlets(std::span<const GLuint> elements, std::span<const GLfloat> vertexBuffer, GLuint floatsPerVertex, GLint normalOffset);
+
+    /**
+     * Join triangles that share edges into triangle strips, separated by STRIP_RESTART_INDEX for primitive restart.
+     * Each strip starts at the first unused triangle in element order, so strips follow the vertex cache order, and
+     * is grown greedily across the edge of its last two vertices. Triangle winding is not kept, the generators do not
+     * wind triangles consistently. Triangles with a repeated vertex cover no pixels and are dropped.
+     *
+     * @param triangles The triangle elements.
+     * @param strips The vector to append the strip elements to.
+     */
+    static void stripifyTriangles(std::span<const GLuint> triangles, std::pmr::vector<GLuint>& strips);
+
+    /**
+     * Simulate a FIFO post-transform vertex cache over the triangle elements.
+     *
+     * @param elementBuffer The triangle elements.
+     * @param vertexCount The number of vertices the elements reference.
+     * @param cacheSize The number of vertices in the simulated cache.
+     * @return The cache stats.
+     */
+    static VertexCacheStats analyzeVertexCache(std::span<const GLuint> elementBuffer, size_t vertexCount, GLuint cacheSize = SIMULATED_CACHE_SIZE);
+
+
+    // #############
+    // # Variables #
+    // #############
+
+
+    // Class constants
+    static constexpr GLuint SIMULATED_CACHE_SIZE = 16;      // FIFO cache size stats are reported for
+    static constexpr GLuint FORSYTH_CACHE_SIZE = 32;        // LRU cache size triangles are scored for
+    static constexpr float OVERDRAW_ACMR_THRESHOLD = 1.05f; // ACMR increase allowed when splitting overdraw clusters
+    static constexpr GLuint MAX_MESHLET_VERTICES = 64;      // Most unique vertices in a meshlet
+    static constexpr GLuint MAX_MESHLET_TRIANGLES = 124;    // Most triangles in a meshlet
+    static constexpr GLuint STRIP_RESTART_INDEX = 0xFFFFFFFF;   // Element between strips, narrowed to the fixed restart index of the index type
+};
@@ -1,4 +1,5 @@
 #include "PS5ControllerMesh.h"
+#include "CompositeMeshBuilder.h"
 #include "PyramidMesh.h"
 #include "CubeMesh.h"
 #include "CubeLightMesh.h"
@@ -22,12 +23,12 @@
 
 
 PS5ControllerMesh::PS5ControllerMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, glm::vec3 scale, glm::vec3 rotationDegrees, glm::vec3 translation, RotationOrder rotationOrder, GLuint shaderProgramId, int sectorCount)
-    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), sectorCount(sectorCount)
+    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), sectorCount(sectorCount), fullSectorCount(sectorCount)
 {
 }
 
 PS5ControllerMesh::PS5ControllerMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, GLuint shaderProgramId, int sectorCount)
-    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), sectorCount(sectorCount)
+    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), sectorCount(sectorCount), fullSectorCount(sectorCount)
 {
 }
 
@@ -59,7 +60,8 @@ void PS5ControllerMesh::generateVertices()
     float joyStickTopHeight = 0.4f;
     float joyStickTopRadius = 0.9f;
 
-    std::vector<Mesh*> meshes;
+    // Parts are generated untransformed, then built into the buffers with their transforms in one pass
+    CompositeMeshBuilder builder(vertexMode);
 
     // Controller Body
     CubeMesh controllerBody(vertexMode, UnitOfMeasure::CENTIMETER, -1, (bodyWidth - bodyCurveRadius * 2.0f), bodyHeight, (bodyLength - bodyCurveRadius));
@@ -67,8 +69,7 @@ void PS5ControllerMesh::generateVertices()
     controllerBody.rotateMesh(-10.0f, 0.0f, 0.0f);
     controllerBody.setColor(color);
     controllerBody.generateVertices();
-    controllerBody.translateMeshPreVAO();
-    meshes.push_back(&controllerBody);
+    builder.addPart(controllerBody);
 
     CylinderMesh leftBodyCurve(vertexMode, UnitOfMeasure::CENTIMETER, -1, bodyCurveRadius, (bodyLength - bodyCurveRadius - 0.001f), 100);
     leftBodyCurve.setTextureUClamp(glm::vec2(0.0f, 2.0f / 3.0f));
@@ -77,8 +78,7 @@ void PS5ControllerMesh::generateVertices()
     leftBodyCurve.rotateMesh(-100.0f, 180.0f, 0.0f);
     leftBodyCurve.setColor(color);
     leftBodyCurve.generateVertices();
-    leftBodyCurve.translateMeshPreVAO();
-    meshes.push_back(&leftBodyCurve);
+    builder.addPart(leftBodyCurve);
 
     CylinderMesh rightBodyCurve(vertexMode, UnitOfMeasure::CENTIMETER, -1, bodyCurveRadius, (bodyLength - bodyCurveRadius - 0.001f), 100);
     rightBodyCurve.setTextureUClamp(glm::vec2(0.0f, 2.0f / 3.0f));
@@ -87,8 +87,7 @@ void PS5ControllerMesh::generateVertices()
     rightBodyCurve.rotateMesh(-100.0f, 180.0f, 0.0f);
     rightBodyCurve.setColor(color);
     rightBodyCurve.generateVertices();
-    rightBodyCurve.translateMeshPreVAO();
-    meshes.push_back(&rightBodyCurve);
+    builder.addPart(rightBodyCurve);
 
     CylinderMesh frontBodyCurve(vertexMode, UnitOfMeasure::CENTIMETER, -1, bodyCurveRadius, (bodyWidth - bodyCurveRadius * 2.0f), 100);
     frontBodyCurve.setTextureUClamp(glm::vec2(1.0f / 3.0f, 1.0f));
@@ -96,8 +95,7 @@ void PS5ControllerMesh::generateVertices()
     frontBodyCurve.rotateMesh(0.0f, -80.0f, -90.0f, RotationOrder::Y_Z_X);
     frontBodyCurve.setColor(color);
     frontBodyCurve.generateVertices();
-    frontBodyCurve.translateMeshPreVAO();
-    meshes.push_back(&frontBodyCurve);
+    builder.addPart(frontBodyCurve);
 
     // Controller Handles
     CylinderMesh leftHandle(vertexMode, UnitOfMeasure::CENTIMETER, -1, bodyCurveRadius, (handleLength - handleRadius), 100);
@@ -106,8 +104,7 @@ void PS5ControllerMesh::generateVertices()
     leftHandle.rotateMesh(-80.0f, 180.0f, -15.0f, RotationOrder::Y_Z_X);
     leftHandle.setColor(color);
     leftHandle.generateVertices();
-    leftHandle.translateMeshPreVAO();
-    meshes.push_back(&leftHandle);
+    builder.addPart(leftHandle);
 
     SphereMesh leftHandleEnd(vertexMode, UnitOfMeasure::CENTIMETER, -1, bodyCurveRadius - 0.001f, sectorCount, sectorCount);
     leftHandleEnd.setTextureUClamp(glm::vec2(0.0f, 2.0f / 3.0f));
@@ -116,8 +113,7 @@ void PS5ControllerMesh::generateVertices()
     leftHandleEnd.rotateMesh(10.0f, 0.0f, 0.0f);
     leftHandleEnd.setColor(color);
     leftHandleEnd.generateVertices();
-    leftHandleEnd.translateMeshPreVAO();
-    meshes.push_back(&leftHandleEnd);
+    builder.addPart(leftHandleEnd);
 
     CylinderMesh rightHandle(vertexMode, UnitOfMeasure::CENTIMETER, -1, bodyCurveRadius, (handleLength - handleRadius), 100);
     rightHandle.setTextureUClamp(glm::vec2(0.0f, 2.0f / 3.0f));
@@ -125,8 +121,7 @@ void PS5ControllerMesh::generateVertices()
     rightHandle.rotateMesh(-80.0f, 180.0f, 15.0f, RotationOrder::Y_Z_X);
     rightHandle.setColor(color);
     rightHandle.generateVertices();
-    rightHandle.translateMeshPreVAO();
-    meshes.push_back(&rightHandle);
+    builder.addPart(rightHandle);
 
     SphereMesh rightHandleEnd(vertexMode, UnitOfMeasure::CENTIMETER, -1, bodyCurveRadius - 0.001f, sectorCount, sectorCount);
     rightHandleEnd.setTextureUClamp(glm::vec2(0.0f, 2.0f / 3.0f));
@@ -135,8 +130,7 @@ void PS5ControllerMesh::generateVertices()
     rightHandleEnd.rotateMesh(10.0f, 0.0f, 0.0f);
     rightHandleEnd.setColor(color);
     rightHandleEnd.generateVertices();
-    rightHandleEnd.translateMeshPreVAO();
-    meshes.push_back(&rightHandleEnd);
+    builder.addPart(rightHandleEnd);
 
     // Controller Joysticks
     TorusMesh leftJoystickOpening(vertexMode, UnitOfMeasure::CENTIMETER, -1, joyStickOpeningRadius + joyStickOpeningThickness, joyStickOpeningRadius, sectorCount, sectorCount);
@@ -146,8 +140,7 @@ void PS5ControllerMesh::generateVertices()
     leftJoystickOpening.rotateMesh(-100.0f, 0.0f, 0.0f);
     leftJoystickOpening.setColor(color);
     leftJoystickOpening.generateVertices();
-    leftJoystickOpening.translateMeshPreVAO();
-    meshes.push_back(&leftJoystickOpening);
+    builder.addPart(leftJoystickOpening);
 
     CylinderMesh leftJoystickStem(vertexMode, UnitOfMeasure::CENTIMETER, -1, joyStickStemRadius, joyStickStemHeight, sectorCount);
     leftJoystickStem.setTextureUClamp(glm::vec2(0.0f, 1.0f / 3.0f));
@@ -156,8 +149,7 @@ void PS5ControllerMesh::generateVertices()
     leftJoystickStem.rotateMesh(-10.0f, 0.0f, 0.0f);
     leftJoystickStem.setColor(color);
     leftJoystickStem.generateVertices();
-    leftJoystickStem.translateMeshPreVAO();
-    meshes.push_back(&leftJoystickStem);
+    builder.addPart(leftJoystickStem);
 
     CylinderMesh leftJoystickTop(vertexMode, UnitOfMeasure::CENTIMETER, -1, joyStickTopRadius, joyStickTopHeight, sectorCount);
     leftJoystickTop.setTextureUClamp(glm::vec2(0.0f, 1.0f / 3.0f));
@@ -166,8 +158,7 @@ void PS5ControllerMesh::generateVertices()
     leftJoystickTop.rotateMesh(-10.0f, 0.0f, 0.0f);
     leftJoystickTop.setColor(color);
     leftJoystickTop.generateVertices();
-    leftJoystickTop.translateMeshPreVAO();
-    meshes.push_back(&leftJoystickTop);
+    builder.addPart(leftJoystickTop);
 
     TorusMesh rightJoystickOpening(vertexMode, UnitOfMeasure::CENTIMETER, -1, joyStickOpeningRadius + joyStickOpeningThickness, joyStickOpeningRadius, sectorCount, sectorCount);
     rightJoystickOpening.setTextureUClamp(glm::vec2(0.0f, 1.0f / 3.0f));
@@ -176,8 +167,7 @@ void PS5ControllerMesh::generateVertices()
     rightJoystickOpening.rotateMesh(-100.0f, 0.0f, 0.0f);
     rightJoystickOpening.setColor(color);
     rightJoystickOpening.generateVertices();
-    rightJoystickOpening.translateMeshPreVAO();
-    meshes.push_back(&rightJoystickOpening);
+    builder.addPart(rightJoystickOpening);
 
     CylinderMesh rightJoystickStem(vertexMode, UnitOfMeasure::CENTIMETER, -1, joyStickStemRadius, joyStickStemHeight, sectorCount);
     rightJoystickStem.setTextureUClamp(glm::vec2(0.0f, 1.0f / 3.0f));
@@ -186,8 +176,7 @@ void PS5ControllerMesh::generateVertices()
     rightJoystickStem.rotateMesh(-10.0f, 0.0f, 0.0f);
     rightJoystickStem.setColor(color);
     rightJoystickStem.generateVertices();
-    rightJoystickStem.translateMeshPreVAO();
-    meshes.push_back(&rightJoystickStem);
+    builder.addPart(rightJoystickStem);
 
     CylinderMesh rightJoystickTop(vertexMode, UnitOfMeasure::CENTIMETER, -1, joyStickTopRadius, joyStickTopHeight, sectorCount);
     rightJoystickTop.setTextureUClamp(glm::vec2(0.0f, 1.0f / 3.0f));
@@ -196,23 +185,18 @@ void PS5ControllerMesh::generateVertices()
     rightJoystickTop.rotateMesh(-10.0f, 0.0f, 0.0f);
     rightJoystickTop.setColor(color);
     rightJoystickTop.generateVertices();
-    rightJoystickTop.translateMeshPreVAO();
-    meshes.push_back(&rightJoystickTop);
+    builder.addPart(rightJoystickTop);
 
 
-    int verticesAdded = 0;
+    // Store any existing transformations
+    glm::mat4 scaleTemp = scale;
+    glm::mat4 rotationTemp = rotation;
+    glm::mat4 translationTemp = translation;
 
-    for (Mesh* meshPtr : meshes) {
-        for (GLfloat vertexValue : meshPtr->getVertexBuffer()) {
-            vertexBuffer.push_back(vertexValue);
-        }
-
-        for (GLuint elementValue : meshPtr->getElementBuffer()) {
-            elementBuffer.push_back(elementValue + verticesAdded);
-        }
-
-        verticesAdded = getVertexBufferCount();
-    }
+    // Reset any existing transformations
+    setScale(Mesh::DEFAULT_SCALE_VEC3);
+    setRotation(Mesh::DEFAULT_ROTATION_DEGREES_VEC3);
+    setTranslation(Mesh::DEFAULT_TRANSLATION_VEC3);
 
     // Transform the headset to start at a resting position where the origin is at the center and bottom of the mesh
     translateMesh(0.0f, 2.35f, 0.0f);
@@ -222,5 +206,16 @@ void PS5ControllerMesh::generateVertices()
         scaleMesh(cmToInch, cmToInch, cmToInch);
     }
 
-    translateMeshPreVAO();
+    builder.build(vertexBuffer, elementBuffer, getModel());
+
+    // Set back any existing transformations
+    scale = scaleTemp;
+    rotation = rotationTemp;
+    translation = translationTemp;
+}
+
+float PS5ControllerMesh::setDetailLevel(int level)
+{
+    sectorCount = getLODSectorCount(fullSectorCount, level);
+    return 2.0f * glm::pi<float>() / sectorCount;
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+// ParametricSurface.h
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <span>
+#include "VertexFormat.h"
+
+/**
+ * Struct representing the position and normal of a point of a parametric surface.
+ */
+struct SurfacePoint {
+    glm::vec3 position;                     // Position of the point
+    glm::vec3 normal;                       // Unit normal of the surface at the point
+};
+
+/**
+ * Class representing a surface generated over a grid of slices (u) and stacks (v), such as a Sphere or Torus.
+ * The surface functor maps a point of the grid to its position and normal, called as surface(slice, stack) and
+ * returning a SurfacePoint. It is inlined into the vertex loop compiled for each vertex format, so the grid walk,
+ * attribute writes, and triangles are shared by every surface without a call per vertex.
+ * Each grid quad is split into the same 2 triangles, and UVs are the slice and stack fractions of the grid.
+ *
+ * @tparam F The surface functor type.
+ */
+template <typename F>
+class ParametricSurface {
+public:
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * ParametricSurface constructor.
+     *
+     * @param surface The functor mapping a slice and stack to a SurfacePoint.
+     * @param slices The number of slices along u (vertices are generated for 0 to slices).
+     * @param stacks The number of stacks along v (vertices are generated for 0 to stacks).
+     */
+    constexpr ParametricSurface(F surface, int slices, int stacks) : surface(surface), slices(slices), stacks(stacks)
+    {
+    }
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the number of slices along u.
+     *
+     * @return The number of slices.
+     */
+    constexpr int getSlices() const
+    {
+        return slices;
+    }
+
+    /**
+     * Get the number of stacks along v.
+     *
+     * @return The number of stacks.
+     */
+    constexpr int getStacks() const
+    {
+        return stacks;
+    }
+
+    /**
+     * Get the number of vertices of the surface, a row of slices + 1 vertices for each of stacks + 1 rows.
+     *
+     * @return The number of vertices.
+     */
+    constexpr size_t getVertexCount() const
+    {
+        return static_cast<size_t>(slices + 1) * (stacks + 1);
+    }
+
+    /**
+     * Get the number of elements of the surface, 2 triangles per quad of the grid.
+     *
+     * @return The number of elements.
+     */
+    constexpr size_t getElementCount() const
+    {
+        return static_cast<size_t>(slices) * stacks * 6;
+    }
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Generate the vertices of a band of rows and the triangles from each row to the next.
+     * A band only writes its own vertices and elements, so bands can be generated in parallel.
+     *
+     * @tparam VertexType The vertex format to write, attributes it does not have are compiled out.
+     * @tparam UVMap The functor mapping the slice and stack fractions (0 to 1) to the texture UV.
+     * @param vertices The vertices of the whole surface, sized to getVertexCount().
+     * @param elements The elements of the whole surface, sized to getElementCount().
+     * @param rowBegin The first row of the band (inclusive).
+     * @param rowEnd The last row of the band (exclusive, at most stacks + 1).
+     * @param color The color of every vertex in color modes.
+     * @param uvMap The UV mapping.
+     */
+    template <typename VertexType, typename UVMap>
+    void generateRows(std::span<VertexType> vertices, std::span<GLuint> elements, int rowBegin, int rowEnd, const glm::vec4& color, UVMap uvMap) const
+    {
+        size_t vertexIndex = static_cast<size_t>(rowBegin) * (slices + 1);    // Index for the vertices
+
+        // Generate vertices
+        for (int stack = rowBegin; stack < rowEnd; stack++) {
+            for (int slice = 0; slice <= slices; slice++) {
+                SurfacePoint point = surface(slice, stack);
+
+                VertexType& vertex = vertices[vertexIndex++];
+                vertex.template set<Position>(point.position);
+                vertex.template set<Color>(color);
+                vertex.template set<Normal>(point.normal);
+                vertex.template set<UV>(uvMap(glm::vec2(
+                    static_cast<float>(slice) / static_cast<float>(slices),
+                    static_cast<float>(stack) / static_cast<float>(stacks)
+                )));
+            }
+        }
+
+        size_t elementIndex = static_cast<size_t>(rowBegin) * slices * 6;    // Index for the elements
+
+        // Generate indices, the last row of vertices starts no triangles
+        for (int stack = rowBegin; stack < std::min(rowEnd, stacks); stack++) {
+            GLuint row1 = stack * (slices + 1);
+            GLuint row2 = (stack + 1) * (slices + 1);
+            for (int slice = 0; slice < slices; slice++) {
+                elements[elementIndex++] = row1 + slice;
+                elements[elementIndex++] = row2 + slice + 1;
+                elements[elementIndex++] = row2 + slice;
+                elements[elementIndex++] = row1 + slice;
+                elements[elementIndex++] = row1 + slice + 1;
+                elements[elementIndex++] = row2 + slice + 1;
+            }
+        }
+    }
+
+private:
+    // #############
+    // # Variables #
+    // #############
+
+    F surface;                              // Functor mapping a slice and stack to a SurfacePoint
+    int slices;                             // The number of slices along u
+    int stacks;                             // The number of stacks along v
+};
@@ -1,6 +1,7 @@
 #include "ShaderManager.h"
 #include <iostream>         // cout, cerr
 #include <cstdlib>          // EXIT_FAILURE
+#include <string>
 #include <GL/glew.h>        // GLEW library
 #include <GLFW/glfw3.h>     // GLFW library
 
@@ -54,7 +55,42 @@ bool ShaderManager::createShaderProgram(GLuint& programId, VertexMode vertexMode
     }
 }
 
+bool ShaderManager::createBindlessShaderProgram(GLuint& programId)
+{
+    // The shader requires the extension, let the caller fall back instead of failing to compile
+    if (!GLEW_ARB_bindless_texture) {
+        return false;
+    }
+
+    return createShaderProgramPositionNormalUV(programId, true);
+}
+
+bool ShaderManager::createProceduralShaderProgram(GLuint& programId, bool bindlessTextures)
+{
+    // The bindless material requires the extension, let the caller fall back instead of failing to compile
+    if (bindlessTextures && !GLEW_ARB_bindless_texture) {
+        return false;
+    }
+
+    return createShaderProgramPositionNormalUV(programId, bindlessTextures, true);
+}
+
+bool ShaderManager::createTessellationShaderProgram(GLuint& programId, bool bindlessTextures)
+{
+    // The bindless material requires the extension, let the caller fall back instead of failing to compile
+    if (bindlessTextures && !GLEW_ARB_bindless_texture) {
+        return false;
+    }
+
+    return createShaderProgramPositionNormalUV(programId, bindlessTextures, false, true);
+}
+
 bool ShaderManager::createShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId)
+{
+    return createShaderProgram(vtxShaderSource, NULL, NULL, fragShaderSource, programId);
+}
+
+bool ShaderManager::createShaderProgram(const char* vtxShaderSource, const char* tessControlShaderSource, const char* tessEvaluationShaderSource, const char* fragShaderSource, GLuint& programId)
 {
     // Compilation and linkage error reporting
     int success = 0;
@@ -63,41 +99,31 @@ bool ShaderManager::createShaderProgram(const char* vtxShaderSource, const char*
     // Create a Shader program object.
     programId = glCreateProgram();
 
-    // Create the vertex and fragment shader objects
-    GLuint vertexShaderId = glCreateShader(GL_VERTEX_SHADER);
-    GLuint fragmentShaderId = glCreateShader(GL_FRAGMENT_SHADER);
-
-    // Retrive the shader source
-    glShaderSource(vertexShaderId, 1, &vtxShaderSource, NULL);
-    glShaderSource(fragmentShaderId, 1, &fragShaderSource, NULL);
-
-    // Compile the vertex shader, and print compilation errors (if any)
-    glCompileShader(vertexShaderId); // compile the vertex shader
-    // check for shader compile errors
-    glGetShaderiv(vertexShaderId, GL_COMPILE_STATUS, &success);
-    if (!success)
+    // Create, compile, and attach each stage, printing compilation errors (if any)
+    GLuint vertexShaderId = 0;
+    GLuint fragmentShaderId = 0;
+    if (!compileShader(GL_VERTEX_SHADER, vtxShaderSource, "VERTEX", vertexShaderId)
+        || !compileShader(GL_FRAGMENT_SHADER, fragShaderSource, "FRAGMENT", fragmentShaderId))
     {
-        glGetShaderInfoLog(vertexShaderId, 512, NULL, infoLog);
-        std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-
         return false;
     }
+    glAttachShader(programId, vertexShaderId);
+    glAttachShader(programId, fragmentShaderId);
 
-    glCompileShader(fragmentShaderId); // compile the fragment shader
-    // check for shader compile errors
-    glGetShaderiv(fragmentShaderId, GL_COMPILE_STATUS, &success);
-    if (!success)
+    // The tessellation stages are optional, both or neither are given
+    if (tessControlShaderSource != NULL && tessEvaluationShaderSource != NULL)
     {
-        glGetShaderInfoLog(fragmentShaderId, sizeof(infoLog), NULL, infoLog);
-        std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-
-        return false;
+        GLuint tessControlShaderId = 0;
+        GLuint tessEvaluationShaderId = 0;
+        if (!compileShader(GL_TESS_CONTROL_SHADER, tessControlShaderSource, "TESS_CONTROL", tessControlShaderId)
+            || !compileShader(GL_TESS_EVALUATION_SHADER, tessEvaluationShaderSource, "TESS_EVALUATION", tessEvaluationShaderId))
+        {
+            return false;
+        }
+        glAttachShader(programId, tessControlShaderId);
+        glAttachShader(programId, tessEvaluationShaderId);
     }
 
-    // Attached compiled shaders to the shader program
-    glAttachShader(programId, vertexShaderId);
-    glAttachShader(programId, fragmentShaderId);
-
     glLinkProgram(programId);   // links the shader program
     // check for linking errors
     glGetProgramiv(programId, GL_LINK_STATUS, &success);
@@ -114,7 +140,6 @@ bool ShaderManager::createShaderProgram(const char* vtxShaderSource, const char*
     return true;
 }
 
-
 // ###################
 // #                 #
 // # Private methods #
@@ -135,6 +160,30 @@ ShaderManager::ShaderManager() {}
 // #################
 
 
+bool ShaderManager::compileShader(GLenum shaderType, const char* shaderSource, const char* stageName, GLuint& shaderId)
+{
+    // Compilation error reporting
+    int success = 0;
+    char infoLog[512];
+
+    // Create the shader object and retrive the shader source
+    shaderId = glCreateShader(shaderType);
+    glShaderSource(shaderId, 1, &shaderSource, NULL);
+
+    glCompileShader(shaderId);
+    // check for shader compile errors
+    glGetShaderiv(shaderId, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(shaderId, sizeof(infoLog), NULL, infoLog);
+        std::cout << "ERROR::SHADER::" << stageName << "::COMPILATION_FAILED\n" << infoLog << std::endl;
+
+        return false;
+    }
+
+    return true;
+}
+
 bool ShaderManager::createShaderProgramPositionColor(GLuint& programId)
 {
     /* Vertex Shader Source Code*/
@@ -226,7 +275,7 @@ bool ShaderManager::createShaderProgramPositionColorUV(GLuint& programId)
     return false;
 }
 
-bool ShaderManager::createShaderProgramPositionNormalUV(GLuint& programId)
+bool ShaderManager::createShaderProgramPositionNormalUV(GLuint& programId, bool bindlessTextures, bool proceduralVertices, bool tessellatedPatches)
 {
     /* Vertex Shader Source Code*/
     const GLchar* vertexShaderSource = GLSL(460,
@@ -252,17 +301,284 @@ bool ShaderManager::createShaderProgramPositionNormalUV(GLuint& programId)
         }
     );
 
+    /* Procedural Surface Source Code*/
+    // Parametric surfaces shared by the procedural vertex shader and the tessellation shaders
+    const GLchar* proceduralSurfaceSource = GLSL_SOURCE(
+        struct Procedural {
+            int shape;                  // 1 = sphere, 2 = torus, 3 = frustum (ProceduralShape)
+            vec4 dimensions;            // Sphere radius, torus center and tube radius, or frustum top radius, bottom radius, and height
+            ivec2 divisions;            // Slices and stacks, or sectors (patches around and down when tessellated)
+            vec4 textureClamp;          // U minimum, U ratio, V minimum, V ratio
+        };
 
-    /* Fragment Shader Source Code*/
-    const GLchar* fragmentShaderSource = GLSL(460,
-        out vec4 FragColor;
+        uniform mat4 model;
+        uniform mat4 view;
+        uniform mat4 projection;
+        uniform Procedural procedural;
 
-        struct Material {
-            sampler2D diffuse;
-            sampler2D specular;
-            float shininess;
+        const float PI = 3.14159265358979;
+
+        // builds a sphere or torus vertex at a point of its slice and stack grid, 0 to 1 each way.
+        // Angles of full turns wrap, so both sides of a seam build the same position and normal.
+        void GridVertex(vec2 grid, out vec3 position, out vec3 normal, out vec2 uv)
+        {
+            uv = grid;
+            float horizontalAngle = fract(uv.x) * 2.0 * PI;
+            if (procedural.shape == 1) {
+                float verticalAngle = uv.y * PI - PI / 2.0;
+                normal = vec3(cos(horizontalAngle) * cos(verticalAngle), sin(horizontalAngle) * cos(verticalAngle), sin(verticalAngle));
+                position = procedural.dimensions.x * normal;
+            }
+            else {
+                float verticalAngle = fract(uv.y) * 2.0 * PI - PI;
+                float ringRadius = procedural.dimensions.x + procedural.dimensions.y * cos(horizontalAngle);
+                normal = vec3(cos(horizontalAngle) * cos(verticalAngle), cos(horizontalAngle) * sin(verticalAngle), sin(horizontalAngle));
+                position = vec3(ringRadius * cos(verticalAngle), ringRadius * sin(verticalAngle), procedural.dimensions.y * sin(horizontalAngle));
+            }
+        }
+    );
+
+    /* Procedural Vertex Shader Source Code*/
+    // Vertex pulling, each vertex is built from its triangle and corner in the order the mesh generators emit them
+    const GLchar* proceduralVertexShaderSource = GLSL_SOURCE(
+        out vec3 FragPos;
+        out vec3 Normal;
+        out vec2 TexCoords;
+
+        // Slice and stack offsets of the corners of the 2 triangles of a grid quad
+        const ivec2 QUAD_CORNERS[6] = ivec2[6](ivec2(0, 0), ivec2(1, 1), ivec2(0, 1), ivec2(0, 0), ivec2(1, 0), ivec2(1, 1));
+
+        // builds a frustum vertex on the top (side = 1) or bottom (side = -1) circle.
+        vec3 CirclePosition(int sector, float side)
+        {
+            float angle = float(sector) / float(procedural.divisions.x) * 2.0 * PI;
+            float radius = (side > 0.0) ? procedural.dimensions.x : procedural.dimensions.y;
+            return vec3(radius * cos(angle), side * procedural.dimensions.z / 2.0, radius * sin(angle));
+        }
+
+        // maps a frustum circle vertex into its quarter of the texture, the top a quarter turn forward and the bottom a quarter turn back.
+        vec2 CircleUV(int sector, float side)
+        {
+            float angle = float(sector) / float(procedural.divisions.x) * 2.0 * PI;
+            if (side > 0.0)
+                return vec2(0.25 * -sin(angle) + 0.25, 0.25 * cos(angle) + 0.75);
+            return vec2(0.25 * sin(angle) + 0.75, 0.25 * -cos(angle) + 0.75);
+        }
+
+        // builds the corners of a frustum triangle: part 0 is the top, 1 to 3 the side, and 4 the bottom.
+        void FrustumTriangle(int part, int sector, out vec3 positions[3], out vec2 uvs[3])
+        {
+            int sectors = procedural.divisions.x;
+            float sideU = float(sectors - sector) / float(sectors);
+            float nextSideU = float(sectors - sector - 1) / float(sectors);
+            float middleSideU = (sideU + nextSideU) * 0.5;
+            vec3 top = CirclePosition(sector, 1.0);
+            vec3 nextTop = CirclePosition(sector + 1, 1.0);
+            vec3 bottom = CirclePosition(sector, -1.0);
+            vec3 nextBottom = CirclePosition(sector + 1, -1.0);
+            vec3 middleBottom = (bottom + nextBottom) * 0.5;
+
+            if (part == 0) {
+                // The top is inside out, so its UVs run in reverse
+                positions = vec3[3](vec3(0.0, top.y, 0.0), top, nextTop);
+                uvs = vec2[3](vec2(0.25, 0.75), CircleUV(sectors - sector, 1.0), CircleUV(sectors - sector - 1, 1.0));
+            }
+            else if (part == 1) {
+                positions = vec3[3](top, middleBottom, bottom);
+                uvs = vec2[3](vec2(sideU, 0.5), vec2(middleSideU, 0.0), vec2(sideU, 0.0));
+            }
+            else if (part == 2) {
+                positions = vec3[3](top, middleBottom, nextTop);
+                uvs = vec2[3](vec2(sideU, 0.5), vec2(middleSideU, 0.0), vec2(nextSideU, 0.5));
+            }
+            else if (part == 3) {
+                positions = vec3[3](nextTop, middleBottom, nextBottom);
+                uvs = vec2[3](vec2(nextSideU, 0.5), vec2(middleSideU, 0.0), vec2(nextSideU, 0.0));
+            }
+            else {
+                positions = vec3[3](vec3(0.0, bottom.y, 0.0), bottom, nextBottom);
+                uvs = vec2[3](vec2(0.75, 0.75), CircleUV(sector, -1.0), CircleUV(sector + 1, -1.0));
+            }
+        }
+
+        void main()
+        {
+            int triangle = gl_VertexID / 3;
+            int corner = gl_VertexID % 3;
+            vec3 position;
+            vec3 normal;
+            vec2 uv;
+
+            if (procedural.shape == 3) {
+                vec3 positions[3];
+                vec2 uvs[3];
+                FrustumTriangle(triangle / procedural.divisions.x, triangle % procedural.divisions.x, positions, uvs);
+
+                // Flat shaded, the normal of the triangle pointing away from the center
+                normal = cross(positions[1] - positions[0], positions[2] - positions[0]);
+                if (dot(normal, -positions[0]) >= 0.0)
+                    normal = -normal;
+                normal = normalize(normal);
+                position = positions[corner];
+                uv = uvs[corner];
+            }
+            else {
+                int quad = triangle / 2;
+                ivec2 point = ivec2(quad % procedural.divisions.x, quad / procedural.divisions.x) + QUAD_CORNERS[(triangle % 2) * 3 + corner];
+                GridVertex(vec2(point) / vec2(procedural.divisions), position, normal, uv);
+            }
+
+            FragPos = vec3(model * vec4(position, 1.0));
+            Normal = mat3(transpose(inverse(model))) * normal;
+            TexCoords = uv * procedural.textureClamp.yw + procedural.textureClamp.xz;
+
+            gl_Position = projection * view * vec4(FragPos, 1.0);
+        }
+    );
+
+    /* Patch Surface Source Code*/
+    // Tessellated patches, one patch vertex each, cover the slice and stack grid or the frustum top, side, and bottom
+    const GLchar* patchSurfaceSource = GLSL_SOURCE(
+        // builds a frustum vertex, 0 to 1 around and from the center of the top (region 0) down the side (1) to the center of the bottom (2).
+        void FrustumVertex(int region, vec2 parameter, out vec3 position, out vec3 normal, out vec2 uv)
+        {
+            float angle = fract(parameter.x) * 2.0 * PI;
+            float height = procedural.dimensions.z;
+            vec3 top = vec3(procedural.dimensions.x * cos(angle), height / 2.0, procedural.dimensions.x * sin(angle));
+            vec3 bottom = vec3(procedural.dimensions.y * cos(angle), -height / 2.0, procedural.dimensions.y * sin(angle));
+
+            if (region == 0) {
+                position = vec3(top.x * parameter.y, top.y, top.z * parameter.y);
+                normal = vec3(0.0, 1.0, 0.0);
+                uv = vec2(0.25 * sin(angle) * parameter.y + 0.25, 0.25 * cos(angle) * parameter.y + 0.75);
+            }
+            else if (region == 1) {
+                // Smooth normals, the slope of the side leans them up or down
+                position = mix(top, bottom, parameter.y);
+                normal = normalize(vec3(height * cos(angle), procedural.dimensions.y - procedural.dimensions.x, height * sin(angle)));
+                uv = vec2(1.0 - parameter.x, 0.5 * (1.0 - parameter.y));
+            }
+            else {
+                float rim = 1.0 - parameter.y;
+                position = vec3(bottom.x * rim, bottom.y, bottom.z * rim);
+                normal = vec3(0.0, -1.0, 0.0);
+                uv = vec2(0.25 * sin(angle) * rim + 0.75, -0.25 * cos(angle) * rim + 0.75);
+            }
+        }
+
+        // builds the vertex at a point of a patch, 0 to 1 across and down the patch.
+        void PatchVertex(int patchId, vec2 point, out vec3 position, out vec3 normal, out vec2 uv)
+        {
+            ivec2 patchIndex = ivec2(patchId % procedural.divisions.x, patchId / procedural.divisions.x);
+            if (procedural.shape == 3) {
+                vec2 parameter = vec2((float(patchIndex.x) + point.x) / float(procedural.divisions.x), point.y);
+                FrustumVertex(patchIndex.y, parameter, position, normal, uv);
+            }
+            else {
+                GridVertex((vec2(patchIndex) + point) / vec2(procedural.divisions), position, normal, uv);
+            }
+        }
+    );
+
+    /* Patch Vertex Shader Source Code*/
+    // Patches are built in the tessellation shaders from gl_PrimitiveID, the patch vertex carries nothing
+    const GLchar* patchVertexShaderSource = GLSL(460,
+        void main()
+        {
+        }
+    );
+
+    /* Tessellation Control Shader Source Code*/
+    // Subdivides each edge of a patch by its length on screen. A shared edge is always measured as the u = 0 or v = 0 edge
+    // of the same patch, wrapped around the seams, so the patches on both sides get the same level and meet without cracks
+    const GLchar* tessControlShaderSource = GLSL_SOURCE(
+        layout(vertices = 1) out;
+
+        struct Tessellation {
+            vec2 viewportSize;          // Size of the viewport in pixels
+            float pixelsPerEdge;        // Target length of a tessellated edge on screen
         };
 
+        uniform Tessellation tessellation;
+
+        // projects a point of a patch to pixels.
+        vec2 ScreenPoint(ivec2 patchIndex, vec2 point)
+        {
+            vec3 position;
+            vec3 normal;
+            vec2 uv;
+            PatchVertex(patchIndex.y * procedural.divisions.x + patchIndex.x, point, position, normal, uv);
+            vec4 clip = projection * view * model * vec4(position, 1.0);
+
+            // Points behind the camera are pushed far off screen so their edges get the most detail
+            return clip.xy / max(clip.w, 0.0001) * 0.5 * tessellation.viewportSize;
+        }
+
+        // picks the level of an edge of a patch from its length on screen, through its middle so curved edges are not measured short.
+        float EdgeLevel(ivec2 patchIndex, vec2 start, vec2 end)
+        {
+            vec2 startPoint = ScreenPoint(patchIndex, start);
+            vec2 middlePoint = ScreenPoint(patchIndex, (start + end) * 0.5);
+            vec2 endPoint = ScreenPoint(patchIndex, end);
+            precise float pixels = distance(startPoint, middlePoint) + distance(middlePoint, endPoint);
+            return clamp(pixels / tessellation.pixelsPerEdge, 1.0, float(gl_MaxTessGenLevel));
+        }
+
+        void main()
+        {
+            ivec2 divisions = procedural.divisions;
+            ivec2 patchIndex = ivec2(gl_PrimitiveID % divisions.x, gl_PrimitiveID / divisions.x);
+
+            // The u = 1 edge is the u = 0 edge of the next patch around, the first one past the u seam
+            ivec2 nextColumn = ivec2((patchIndex.x + 1) % divisions.x, patchIndex.y);
+
+            // The v = 1 edge is the v = 0 edge of the next patch down, the torus also wraps around its tube.
+            // The last row of the sphere and frustum has no patch below, so it measures its own v = 1 edge.
+            ivec2 nextRow = ivec2(patchIndex.x, patchIndex.y + 1);
+            if (procedural.shape == 2)
+                nextRow.y = nextRow.y % divisions.y;
+
+            // Outer levels are the u = 0, v = 0, u = 1, and v = 1 edges
+            gl_TessLevelOuter[0] = EdgeLevel(patchIndex, vec2(0.0, 0.0), vec2(0.0, 1.0));
+            gl_TessLevelOuter[1] = EdgeLevel(patchIndex, vec2(0.0, 0.0), vec2(1.0, 0.0));
+            gl_TessLevelOuter[2] = EdgeLevel(nextColumn, vec2(0.0, 0.0), vec2(0.0, 1.0));
+            gl_TessLevelOuter[3] = (nextRow.y < divisions.y)
+                ? EdgeLevel(nextRow, vec2(0.0, 0.0), vec2(1.0, 0.0))
+                : EdgeLevel(patchIndex, vec2(0.0, 1.0), vec2(1.0, 1.0));
+            gl_TessLevelInner[0] = max(gl_TessLevelOuter[1], gl_TessLevelOuter[3]);
+            gl_TessLevelInner[1] = max(gl_TessLevelOuter[0], gl_TessLevelOuter[2]);
+        }
+    );
+
+    /* Tessellation Evaluation Shader Source Code*/
+    const GLchar* tessEvaluationShaderSource = GLSL_SOURCE(
+        layout(quads, fractional_odd_spacing, ccw) in;
+
+        out vec3 FragPos;
+        out vec3 Normal;
+        out vec2 TexCoords;
+
+        void main()
+        {
+            vec3 position;
+            vec3 normal;
+            vec2 uv;
+            PatchVertex(gl_PrimitiveID, gl_TessCoord.xy, position, normal, uv);
+
+            FragPos = vec3(model * vec4(position, 1.0));
+            Normal = mat3(transpose(inverse(model))) * normal;
+            TexCoords = uv * procedural.textureClamp.yw + procedural.textureClamp.xz;
+
+            gl_Position = projection * view * vec4(FragPos, 1.0);
+        }
+    );
+
+
+    /* Fragment Shader Source Code*/
+    // Lighting shared by both material paths, the material source appended after it defines the material functions
+    const GLchar* lightingShaderSource = GLSL_SOURCE(
+        out vec4 FragColor;
+
         struct DirLight {
             vec3 direction;
 
@@ -311,12 +627,14 @@ bool ShaderManager::createShaderProgramPositionNormalUV(GLuint& programId)
         uniform int pointLightCount;
         uniform PointLight pointLights[MAX_POINT_LIGHTS];
         uniform SpotLight spotLight;
-        uniform Material material;
 
         // function prototypes
         vec3 CalcDirLight(DirLight light, vec3 normal, vec3 viewDir);
         vec3 CalcPointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
         vec3 CalcSpotLight(SpotLight light, vec3 normal, vec3 fragPos, vec3 viewDir);
+        vec3 SampleDiffuse();
+        vec3 SampleSpecular();
+        float MaterialShininess();
 
         void main()
         {
@@ -349,11 +667,11 @@ bool ShaderManager::createShaderProgramPositionNormalUV(GLuint& programId)
             float diff = max(dot(normal, lightDir), 0.0);
             // specular shading
             vec3 reflectDir = reflect(-lightDir, normal);
-            float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+            float spec = pow(max(dot(viewDir, reflectDir), 0.0), MaterialShininess());
             // combine results
-            vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-            vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-            vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
+            vec3 ambient = light.ambient * SampleDiffuse();
+            vec3 diffuse = light.diffuse * diff * SampleDiffuse();
+            vec3 specular = light.specular * spec * SampleSpecular();
             return (ambient + diffuse + specular);
         }
 
@@ -365,14 +683,14 @@ bool ShaderManager::createShaderProgramPositionNormalUV(GLuint& programId)
             float diff = max(dot(normal, lightDir), 0.0);
             // specular shading
             vec3 reflectDir = reflect(-lightDir, normal);
-            float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+            float spec = pow(max(dot(viewDir, reflectDir), 0.0), MaterialShininess());
             // attenuation
             float distance = length(light.position - fragPos);
             float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
             // combine results
-            vec3 ambient = light.color * light.ambientStrength * vec3(texture(material.diffuse, TexCoords));
-            vec3 diffuse = light.color * light.diffuseStrength * diff * vec3(texture(material.diffuse, TexCoords));
-            vec3 specular = light.color * light.specularStrength * spec * vec3(texture(material.specular, TexCoords));
+            vec3 ambient = light.color * light.ambientStrength * SampleDiffuse();
+            vec3 diffuse = light.color * light.diffuseStrength * diff * SampleDiffuse();
+            vec3 specular = light.color * light.specularStrength * spec * SampleSpecular();
             ambient *= attenuation;
             diffuse *= attenuation;
             specular *= attenuation;
@@ -387,7 +705,7 @@ bool ShaderManager::createShaderProgramPositionNormalUV(GLuint& programId)
             float diff = max(dot(normal, lightDir), 0.0);
             // specular shading
             vec3 reflectDir = reflect(-lightDir, normal);
-            float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+            float spec = pow(max(dot(viewDir, reflectDir), 0.0), MaterialShininess());
             // attenuation
             float distance = length(light.position - fragPos);
             float attenuation = 1.0 / (light.constant + light.linear * distance + light.quadratic * (distance * distance));
@@ -396,15 +714,104 @@ bool ShaderManager::createShaderProgramPositionNormalUV(GLuint& programId)
             float epsilon = light.cutOff - light.outerCutOff;
             float intensity = clamp((theta - light.outerCutOff) / epsilon, 0.0, 1.0);
             // combine results
-            vec3 ambient = light.ambient * vec3(texture(material.diffuse, TexCoords));
-            vec3 diffuse = light.diffuse * diff * vec3(texture(material.diffuse, TexCoords));
-            vec3 specular = light.specular * spec * vec3(texture(material.specular, TexCoords));
+            vec3 ambient = light.ambient * SampleDiffuse();
+            vec3 diffuse = light.diffuse * diff * SampleDiffuse();
+            vec3 specular = light.specular * spec * SampleSpecular();
             ambient *= attenuation * intensity;
             diffuse *= attenuation * intensity;
             specular *= attenuation * intensity;
             return (ambient + diffuse + specular);
         }
+
     );
 
-    return createShaderProgram(vertexShaderSource, fragmentShaderSource, programId);
+    // Material maps bound on texture units or packed in texture arrays
+    const GLchar* materialShaderSource = GLSL_SOURCE(
+        struct Material {
+            sampler2D diffuse;
+            sampler2D specular;
+            sampler2DArray diffuseArray;    // Texture arrays holding the maps when packed
+            sampler2DArray specularArray;
+            int diffuseLayer;               // Layers of the maps in the texture arrays
+            int specularLayer;
+            bool useTextureArrays;          // Sample the texture arrays instead of diffuse and specular
+            float shininess;
+        };
+
+        uniform Material material;
+
+        // samples the diffuse map from its texture array layer or its own texture.
+        vec3 SampleDiffuse()
+        {
+            if (material.useTextureArrays)
+                return vec3(texture(material.diffuseArray, vec3(TexCoords, material.diffuseLayer)));
+            return vec3(texture(material.diffuse, TexCoords));
+        }
+
+        // samples the specular map from its texture array layer or its own texture.
+        vec3 SampleSpecular()
+        {
+            if (material.useTextureArrays)
+                return vec3(texture(material.specularArray, vec3(TexCoords, material.specularLayer)));
+            return vec3(texture(material.specular, TexCoords));
+        }
+
+        float MaterialShininess()
+        {
+            return material.shininess;
+        }
+    );
+
+    // Material maps as resident bindless texture handles, one material per draw in a storage buffer
+    const GLchar* bindlessMaterialShaderSource = GLSL_SOURCE(
+        struct Material {
+            sampler2D diffuse;
+            sampler2D specular;
+            float shininess;
+        };
+
+        layout(std430, binding = 0) readonly buffer MaterialBuffer {
+            Material materials[];
+        };
+
+        uniform int materialIndex;
+
+        // samples the diffuse map through its bindless handle.
+        vec3 SampleDiffuse()
+        {
+            return vec3(texture(materials[materialIndex].diffuse, TexCoords));
+        }
+
+        // samples the specular map through its bindless handle.
+        vec3 SampleSpecular()
+        {
+            return vec3(texture(materials[materialIndex].specular, TexCoords));
+        }
+
+        float MaterialShininess()
+        {
+            return materials[materialIndex].shininess;
+        }
+    );
+
+    std::string fragmentShaderSource;
+    if (bindlessTextures) {
+        fragmentShaderSource = std::string("#version 460 core \n#extension GL_ARB_bindless_texture : require \n") + lightingShaderSource + bindlessMaterialShaderSource;
+    }
+    else {
+        fragmentShaderSource = std::string("#version 460 core \n") + lightingShaderSource + materialShaderSource;
+    }
+
+    if (tessellatedPatches) {
+        std::string tessControlSource = std::string("#version 460 core \n") + proceduralSurfaceSource + patchSurfaceSource + tessControlShaderSource;
+        std::string tessEvaluationSource = std::string("#version 460 core \n") + proceduralSurfaceSource + patchSurfaceSource + tessEvaluationShaderSource;
+        return createShaderProgram(patchVertexShaderSource, tessControlSource.c_str(), tessEvaluationSource.c_str(), fragmentShaderSource.c_str(), programId);
+    }
+
+    if (proceduralVertices) {
+        std::string proceduralSource = std::string("#version 460 core \n") + proceduralSurfaceSource + proceduralVertexShaderSource;
+        return createShaderProgram(proceduralSource.c_str(), fragmentShaderSource.c_str(), programId);
+    }
+
+    return createShaderProgram(vertexShaderSource, fragmentShaderSource.c_str(), programId);
 }
@@ -9,6 +9,11 @@
 #define GLSL(Version, Source) "#version " #Version " core \n" #Source
 #endif
 
+/*Shader source Macro without version, for sources joined after a version header*/
+#ifndef GLSL_SOURCE
+#define GLSL_SOURCE(Source) #Source
+#endif
+
 /**
  * Class representing a CubeMesh object with transformations.
  */
@@ -46,6 +51,40 @@ public:
      */
     bool createShaderProgram(GLuint& programId, VertexMode vertexMode);
 
+    /**
+     * Create a shader program in the provided programId reference for POSITION_NORMAL_UV meshes that samples
+     * the material maps through GL_ARB_bindless_texture handles instead of bound textures.
+     * Materials are read from the storage buffer on binding 0, indexed by the materialIndex uniform.
+     *
+     * @param programId Reference to create the program id in
+     * @return False if the extension is not supported or the program failed to build.
+     */
+    bool createBindlessShaderProgram(GLuint& programId);
+
+    /**
+     * Create a shader program in the provided programId reference for POSITION_NORMAL_UV meshes drawn with vertex pulling.
+     * The vertex shader builds the position, normal, and texture UV of spheres, tori, and frusta from gl_VertexID and
+     * the procedural uniforms set by Mesh::drawElements, so the meshes have no vertex attributes.
+     * Lighting and materials are the same as the POSITION_NORMAL_UV program, or the bindless program when bindlessTextures is set.
+     *
+     * @param programId Reference to create the program id in
+     * @param bindlessTextures Sample the material maps through bindless handles, as createBindlessShaderProgram does.
+     * @return False if bindless textures were asked for and the extension is not supported, or the program failed to build.
+     */
+    bool createProceduralShaderProgram(GLuint& programId, bool bindlessTextures = false);
+
+    /**
+     * Create a shader program in the provided programId reference for POSITION_NORMAL_UV meshes drawn as tessellated patches.
+     * The tessellation control shader subdivides each patch edge by its length on screen, aiming for the pixelsPerEdge
+     * of the tessellation uniform, and the evaluation shader builds the same surfaces as the procedural program.
+     * Lighting and materials are the same as the POSITION_NORMAL_UV program, or the bindless program when bindlessTextures is set.
+     *
+     * @param programId Reference to create the program id in
+     * @param bindlessTextures Sample the material maps through bindless handles, as createBindlessShaderProgram does.
+     * @return False if bindless textures were asked for and the extension is not supported, or the program failed to build.
+     */
+    bool createTessellationShaderProgram(GLuint& programId, bool bindlessTextures = false);
+
     /**
      * Create a shader program in the provided programId reference based on the provided Vertex and Fragment shaders
      *
@@ -55,6 +94,17 @@ public:
      */
     bool createShaderProgram(const char* vtxShaderSource, const char* fragShaderSource, GLuint& programId);
 
+    /**
+     * Create a shader program in the provided programId reference based on the provided Vertex, Tessellation, and Fragment shaders
+     *
+     * @param vtxShaderSource Vertex shader source pointer
+     * @param tessControlShaderSource Tessellation control shader source pointer, or NULL without tessellation
+     * @param tessEvaluationShaderSource Tessellation evaluation shader source pointer, or NULL without tessellation
+     * @param fragShaderSource Fragment shader source pointer
+     * @param programId Reference to create the program id in
+     */
+    bool createShaderProgram(const char* vtxShaderSource, const char* tessControlShaderSource, const char* tessEvaluationShaderSource, const char* fragShaderSource, GLuint& programId);
+
 private:
     // ################
     // # Constructors #
@@ -72,6 +122,16 @@ private:
     // #################
 
 
+    /**
+     * Create and compile a shader, printing the compilation errors (if any)
+     *
+     * @param shaderType Stage of the shader, such as GL_VERTEX_SHADER
+     * @param shaderSource Shader source pointer
+     * @param stageName Name of the stage in error messages
+     * @param shaderId Reference to create the shader id in
+     */
+    bool compileShader(GLenum shaderType, const char* shaderSource, const char* stageName, GLuint& shaderId);
+
     /**
      * Create a shader program in the provided programId reference for Position and Color
      * Position;    location = 0
@@ -111,6 +171,9 @@ private:
      * (x, y, z, nx, ny, nz, u, v)
      *
      * @param programId Reference to create the program id in
+     * @param bindlessTextures Sample the material maps through bindless handles in a storage buffer.
+     * @param proceduralVertices Build the vertices from gl_VertexID instead of the vertex attributes.
+     * @param tessellatedPatches Build the vertices in the tessellation shaders from patches subdivided by screen size.
      */
-    bool createShaderProgramPositionNormalUV(GLuint& programId);
+    bool createShaderProgramPositionNormalUV(GLuint& programId, bool bindlessTextures = false, bool proceduralVertices = false, bool tessellatedPatches = false);
 };
@@ -1,4 +1,5 @@
 #include "SodaCanMesh.h"
+#include "CompositeMeshBuilder.h"
 #include "CubeMesh.h"
 #include "CylinderMesh.h"
 #include "FrustumMesh.h"
@@ -17,12 +18,12 @@
 
 
 SodaCanMesh::SodaCanMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, glm::vec3 scale, glm::vec3 rotationDegrees, glm::vec3 translation, RotationOrder rotationOrder, GLuint shaderProgramId, float radius, float height, int sectorCount)
-    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), radius(radius), height(height), sectorCount(sectorCount)
+    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), radius(radius), height(height), sectorCount(sectorCount), fullSectorCount(sectorCount)
 {
 }
 
 SodaCanMesh::SodaCanMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, GLuint shaderProgramId, float radius, float height, int sectorCount)
-    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), radius(radius), height(height), sectorCount(sectorCount)
+    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), radius(radius), height(height), sectorCount(sectorCount), fullSectorCount(sectorCount)
 {
 }
 
@@ -61,7 +62,8 @@ void SodaCanMesh::generateVertices()
     float tabRadius = (0.5f / 3.31f) * radius;
     float tabLength = tabRadius * 2.5f;
 
-    std::vector<Mesh*> meshes;
+    // Parts are generated untransformed, then built into the buffers with their transforms in one pass
+    CompositeMeshBuilder builder(vertexMode);
 
     FrustumMesh canBase(vertexMode, UnitOfMeasure::CENTIMETER, -1, radius, smallRadius, baseHeight, sectorCount);
     canBase.setTextureUClamp(glm::vec2(0.0f, 0.5f));
@@ -69,22 +71,20 @@ void SodaCanMesh::generateVertices()
     canBase.translateMesh(0.0f, -bodyHeight / 2 - baseHeight / 2, 0.0f);
     canBase.setColor(color);
     canBase.generateVertices();
-    canBase.translateMeshPreVAO();
-    meshes.push_back(&canBase);
+    builder.addPart(canBase);
 
     CylinderMesh canBody(vertexMode, UnitOfMeasure::CENTIMETER, -1, radius, bodyHeight, sectorCount);
     canBody.setTextureVClamp(glm::vec2(0.0f, 227.0f / 256.0f));
     canBody.setColor(color);
     canBody.generateVertices();
-    meshes.push_back(&canBody);
+    builder.addPart(canBody);
 
     FrustumMesh canTop(vertexMode, UnitOfMeasure::CENTIMETER, -1, smallRadius, radius, topHeight, sectorCount);
     canTop.setTextureVClamp(glm::vec2(227.0f / 512.0f, 285.0f / 512.0f));
     canTop.translateMesh(0.0f, bodyHeight / 2 + topHeight / 2, 0.0f);
     canTop.setColor(color);
     canTop.generateVertices();
-    canTop.translateMeshPreVAO();
-    meshes.push_back(&canTop);
+    builder.addPart(canTop);
 
     // TODO: Implement canRing as torus
     CylinderMesh canRing(vertexMode, UnitOfMeasure::CENTIMETER, -1, ringRadius, ringHeight, sectorCount);
@@ -93,22 +93,7 @@ void SodaCanMesh::generateVertices()
     canRing.translateMesh(0.0f, bodyHeight / 2 + topHeight + ringHeight / 2, 0.0f);
     canRing.setColor(color);
     canRing.generateVertices();
-    canRing.translateMeshPreVAO();
-    meshes.push_back(&canRing);
-
-    int verticesAdded = 0;
-
-    for (Mesh* meshPtr : meshes) {
-        for (GLfloat vertexValue : meshPtr->getVertexBuffer()) {
-            vertexBuffer.push_back(vertexValue);
-        }
-
-        for (GLuint elementValue : meshPtr->getElementBuffer()) {
-            elementBuffer.push_back(elementValue + verticesAdded);
-        }
-
-        verticesAdded = getVertexBufferCount();
-    }
+    builder.addPart(canRing);
 
     // Store any existing transformations
     glm::mat4 scaleTemp = scale;
@@ -122,10 +107,16 @@ void SodaCanMesh::generateVertices()
 
     float meshHeightOffset = baseHeight + bodyHeight / 2.0f;
     translateMesh(0.0f, meshHeightOffset, 0.0f);
-    translateMeshPreVAO();
+    builder.build(vertexBuffer, elementBuffer, getModel());
 
     // Set back any existing transformations
     scale = scaleTemp;
     rotation = rotationTemp;
     translation = translationTemp;
+}
+
+float SodaCanMesh::setDetailLevel(int level)
+{
+    sectorCount = getLODSectorCount(fullSectorCount, level);
+    return 2.0f * glm::pi<float>() / sectorCount;
 }
\ No newline at end of file
@@ -54,6 +54,20 @@ public:
      */
     void generateVertices() override;
 
+protected:
+    // ############################
+    // # Virtual method overrides #
+    // ############################
+
+
+    /**
+     * Set the detail the vertices are generated with, each level halving the sectors around the SodaCan.
+     *
+     * @param level The level of detail (0 = the detail the SodaCan was created with).
+     * @return The angle between neighboring sectors at the level in radians.
+     */
+    float setDetailLevel(int level) override;
+
 private:
     // #############
     // # Variables #
@@ -62,4 +76,5 @@ private:
     float radius;       // The radius of the SodaCan
     float height;       // The height of the SodaCan from top to bottom (y-axis)
     int sectorCount;    // The number of sectors around the SodaCan (greater = more triangles and detail)
+    int fullSectorCount; // The number of sectors the SodaCan was created with (full detail)
 };
\ No newline at end of file
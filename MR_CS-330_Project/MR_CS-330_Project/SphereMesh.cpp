@@ -1,4 +1,6 @@
 #include "SphereMesh.h"
+#include "GeometryCache.h"
+#include "TrigTable.h"
 
 
 // ##################
@@ -14,12 +16,12 @@
 
 
 SphereMesh::SphereMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, glm::vec3 scale, glm::vec3 rotationDegrees, glm::vec3 translation, RotationOrder rotationOrder, GLuint shaderProgramId, float radius, int slices, int stacks)
-    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), radius(radius), slices(slices), stacks(stacks)
+    : Mesh(vertexMode, unitOfMeasure, scale, rotationDegrees, translation, rotationOrder, shaderProgramId), radius(radius), slices(slices), fullSlices(slices), stacks(stacks), fullStacks(stacks)
 {
 }
 
 SphereMesh::SphereMesh(VertexMode vertexMode, UnitOfMeasure unitOfMeasure, GLuint shaderProgramId, float radius, int slices, int stacks)
-    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), radius(radius), slices(slices), stacks(stacks)
+    : Mesh(vertexMode, unitOfMeasure, shaderProgramId), radius(radius), slices(slices), fullSlices(slices), stacks(stacks), fullStacks(stacks)
 {
 }
 
@@ -35,79 +37,58 @@ void SphereMesh::generateVertices()
     if (color == DEFAULT_COLOR) {
         color = getRandomColor();
     }
-    float r = color.r;
-    float g = color.g;
-    float b = color.b;
-    float a = color.a;
-
-    int numVertices = (slices + 1) * (stacks + 1); // Total number of vertices in the mesh
-
-    // Allocate buffer space for vertices, normals, and texture coordinates
-    int floatsPerAttribute = floatsPerVertex + floatsPerColor + floatsPerNormal + floatsPerUV;
-    vertexBuffer.resize(floatsPerAttribute * numVertices);
-
-    // Allocate buffer space for indices
-    elementBuffer.resize(2 * slices * stacks * 3);
-
-    float horizontalAngleIncrement = 2 * glm::pi<float>() / slices; // Angle increment in the horizontal direction
-    float verticalAngleIncrement = glm::pi<float>() / stacks; // Angle increment in the vertical direction
-    float horizontalAngle, verticalAngle, x, y, z; // Variables for angles and Cartesian coordinates
-    int vertexBufferIndex = 0; // Index for the vertex buffer
-
-    // Generate vertices
-    for (int stack = 0; stack <= stacks; stack++) {
-        verticalAngle = -glm::pi<float>() / 2 + stack * verticalAngleIncrement; // Calculate the vertical angle
-        for (int slice = 0; slice <= slices; slice++) {
-            horizontalAngle = slice * horizontalAngleIncrement; // Calculate the horizontal angle
-
-            // Calculate Cartesian coordinates using spherical coordinates
-            x = glm::cos(horizontalAngle) * glm::cos(verticalAngle);
-            y = glm::sin(horizontalAngle) * glm::cos(verticalAngle);
-            z = glm::sin(verticalAngle);
-
-            // Position
-            vertexBuffer[vertexBufferIndex++] = radius * x; // x-coordinate of vertex
-            vertexBuffer[vertexBufferIndex++] = radius * y; // y-coordinate of vertex
-            vertexBuffer[vertexBufferIndex++] = radius * z; // z-coordinate of vertex
-
-            // Color
-            if (floatsPerColor > 0) {
-                vertexBuffer[vertexBufferIndex++] = r; // r-component of color
-                vertexBuffer[vertexBufferIndex++] = g; // g-component of color
-                vertexBuffer[vertexBufferIndex++] = b; // b-component of color
-                vertexBuffer[vertexBufferIndex++] = a; // a-component of color
-            }
-
-            // Normal
-            if (floatsPerNormal > 0) 
-            {
-                vertexBuffer[vertexBufferIndex++] = x; // x-component of normal
-                vertexBuffer[vertexBufferIndex++] = y; // y-component of normal
-                vertexBuffer[vertexBufferIndex++] = z; // z-component of normal
-            }
-
-            // Texture Coordinates
-            if (floatsPerUV > 0) {
-                vertexBuffer[vertexBufferIndex++] = clampU(static_cast<float>(slice) / static_cast<float>(slices)); // u texture coordinate
-                vertexBuffer[vertexBufferIndex++] = clampV(static_cast<float>(stack) / static_cast<float>(stacks)); // v texture coordinate
-            }
-        }
-    }
 
-    int elementBufferIndex = 0; // Index for the element buffer
-
-    // Generate indices
-    for (int stack = 0; stack < stacks; stack++) {
-        int row1 = stack * (slices + 1);
-        int row2 = (stack + 1) * (slices + 1);
-        for (int slice = 0; slice < slices; slice++) {
-            // Define indices to create triangles for the mesh
-            elementBuffer[elementBufferIndex++] = row1 + slice;
-            elementBuffer[elementBufferIndex++] = row2 + slice + 1;
-            elementBuffer[elementBufferIndex++] = row2 + slice;
-            elementBuffer[elementBufferIndex++] = row1 + slice;
-            elementBuffer[elementBufferIndex++] = row1 + slice + 1;
-            elementBuffer[elementBufferIndex++] = row2 + slice + 1;
-        }
+    // Spheres with the same parameters share their geometry
+    GeometryKey key = getGeometryKey("SphereMesh").add(radius).add(slices).add(stacks);
+    if (loadCachedGeometry(key)) {
+        return;
     }
+
+    // Dispatch on the vertex mode once, the vertex loop is compiled for each vertex format
+    visitVertexFormat(vertexMode, [this](auto vertex) {
+        generateFormattedVertices<decltype(vertex)>();
+    });
+    storeCachedGeometry(key);
+}
+
+float SphereMesh::setDetailLevel(int level)
+{
+    slices = getLODSectorCount(fullSlices, level);
+    stacks = getLODSectorCount(fullStacks, level);
+    return std::max(2.0f * glm::pi<float>() / slices, glm::pi<float>() / stacks);
+}
+
+bool SphereMesh::getProceduralGeometry(ProceduralGeometry& geometry) const
+{
+    geometry.shape = PROCEDURAL_SPHERE;
+    geometry.dimensions = glm::vec4(radius, 0.0f, 0.0f, 0.0f);
+    geometry.divisions = glm::ivec2(slices, stacks);
+    geometry.vertexCount = 2 * slices * stacks * 3;
+    return true;
+}
+
+
+// ###################
+// #                 #
+// # Private methods #
+// #                 #
+// ###################
+
+
+template <typename VertexType>
+void SphereMesh::generateFormattedVertices()
+{
+    // Sines and cosines of the horizontal (around) and vertical (bottom to top) angles, shared by every vertex
+    const TrigTable& horizontalAngles = TrigTable::get(slices, 0.0f, 2 * glm::pi<float>());
+    const TrigTable& verticalAngles = TrigTable::get(stacks, -glm::pi<float>() / 2, glm::pi<float>());
+    float radius = this->radius;
+
+    // Spherical coordinates, the normal points from the center through the vertex
+    ParametricSurface surface([&](int slice, int stack) {
+        float verticalAngleCos = verticalAngles.getCos(stack);
+        glm::vec3 normal(horizontalAngles.getCos(slice) * verticalAngleCos, horizontalAngles.getSin(slice) * verticalAngleCos, verticalAngles.getSin(stack));
+        return SurfacePoint{ radius * normal, normal };
+    }, slices, stacks);
+
+    generateParametricSurface<VertexType>(surface);
 }
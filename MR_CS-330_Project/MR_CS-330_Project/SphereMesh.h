@@ -54,7 +54,42 @@ public:
      */
     void generateVertices() override;
 
+protected:
+    // ############################
+    // # Virtual method overrides #
+    // ############################
+
+
+    /**
+     * Set the detail the vertices are generated with, each level halving the slices and stacks of the Sphere.
+     *
+     * @param level The level of detail (0 = the detail the Sphere was created with).
+     * @return The largest angle between neighboring slices or stacks at the level in radians.
+     */
+    float setDetailLevel(int level) override;
+
+    /**
+     * Get the parameters the procedural vertex shader builds the Sphere from, at the current detail level.
+     *
+     * @param geometry Reference to store the parameters in.
+     * @return True, a Sphere can always be pulled.
+     */
+    bool getProceduralGeometry(ProceduralGeometry& geometry) const override;
+
 private:
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Generate the vertex and element buffer in a vertex format.
+     *
+     * @tparam VertexType The vertex format matching the vertex mode.
+     */
+    template <typename VertexType>
+    void generateFormattedVertices();
+
 
     // #############
     // # Variables #
@@ -62,5 +97,7 @@ private:
 
     float radius;   // The radius of the Sphere
     int slices;     // The number of slices around the Sphere (greater = more triangles and detail)
+    int fullSlices; // The number of slices the Sphere was created with (full detail)
     int stacks;     // The number of stacks down the Sphere (greater = more triangles and detail)
+    int fullStacks; // The number of stacks the Sphere was created with (full detail)
 };
\ No newline at end of file
@@ -1,106 +1,826 @@
-//#include "TextureManager.h"
-//
-//using namespace std;
-//
-//// ##################
-//// #                #
-//// # Public methods #
-//// #                #
-//// ##################
-//
-//
-//// ######################
-//// # Singleton Instance #
-//// ######################
-//
-//
-//TextureManager& TextureManager::getInstance()
-//{
-//    static TextureManager instance;
-//    return instance;
-//}
-//
-//
-//// #################
-//// # Other methods #
-//// #################
-//
-//
-//bool TextureManager::createTexture(const char* filename, GLuint& textureId)
-//{
-//    int width, height, channels;
-//    unsigned char* image = stbi_load(filename, &width, &height, &channels, 0);
-//    if (image)
-//    {
-//        flipImageVertically(image, width, height, channels);
-//
-//        glGenTextures(1, &textureId);
-//        glBindTexture(GL_TEXTURE_2D, textureId);
-//
-//        // set the texture wrapping parameters
-//        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-//        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-//        // set texture filtering parameters
-//        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-//        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-//
-//        if (channels == 3)
-//            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-//        else if (channels == 4)
-//            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-//        else
-//        {
-//            cout << "Not implemented to handle image with " << channels << " channels" << endl;
-//            return false;
-//        }
-//
-//        glGenerateMipmap(GL_TEXTURE_2D);
-//
-//        stbi_image_free(image);
-//        glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
-//
-//        return true;
-//    }
-//
-//    // Error loading the image
-//    return false;
-//}
-//
-//
-//// ###################
-//// #                 #
-//// # Private methods #
-//// #                 #
-//// ###################
-//
-//
-//// ################
-//// # Constructors #
-//// ################
-//
-//
-//TextureManager::TextureManager() {}
-//
-//
-//// #################
-//// # Other methods #
-//// #################
-//
-//
-//void TextureManager::flipImageVertically(unsigned char* image, int width, int height, int channels)
-//{
-//    for (int j = 0; j < height / 2; ++j)
-//    {
-//        int index1 = j * width * channels;
-//        int index2 = (height - 1 - j) * width * channels;
-//
-//        for (int i = width * channels; i > 0; --i)
-//        {
-//            unsigned char tmp = image[index1];
-//            image[index1] = image[index2];
-//            image[index2] = tmp;
-//            ++index1;
-//            ++index2;
-//        }
-//    }
-//}
+#include "TextureManager.h"
+#include "TextureResidencyManager.h"
+#include "ThreadPool.h"
+#include "stb_image.h"      // Image loading Utility functions
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <tuple>
+#include <iostream>         // cout, cerr
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>      // SSE intrinsics for the vertical filter pass
+#define TEXTURE_MANAGER_SSE
+#endif
+
+using namespace std;
+
+// Unnamed namespace
+namespace
+{
+    // Mip cache file layout: header, one level entry per level, then the pixels of each level in order
+    const uint32_t MIP_CACHE_MAGIC = 0x4350494D;    // "MIPC"
+    const uint32_t MIP_CACHE_VERSION = 2;
+
+    struct MipCacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceHash;        // Hash of the contents of the image the cache was cooked from
+        int64_t sourceWriteTime;    // Last write time of the image the cache was cooked from
+        int32_t channels;
+        int32_t levelCount;
+        double cookMilliseconds;    // Time spent decoding and filtering when the cache was cooked
+    };
+
+    struct MipCacheLevel {
+        int32_t width;
+        int32_t height;
+        uint64_t byteSize;
+    };
+
+    // Number of steps in the linear to sRGB lookup table, fine enough to round trip every 8 bit sRGB value
+    const int LINEAR_TO_SRGB_STEPS = 16384;
+
+    // Precomputed source texel indices and weights for resampling one axis
+    struct FilterTaps {
+        int tapCount;                   // Taps per destination texel
+        std::vector<int> indices;       // Source texel index per tap (wrapped to match GL_REPEAT)
+        std::vector<float> weights;     // Normalized weight per tap
+    };
+
+    const std::vector<float>& getSrgbToLinearTable()
+    {
+        static const std::vector<float> table = []() {
+            std::vector<float> values(256);
+            for (int i = 0; i < 256; ++i) {
+                float srgb = i / 255.0f;
+                values[i] = (srgb <= 0.04045f) ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    const std::vector<unsigned char>& getLinearToSrgbTable()
+    {
+        static const std::vector<unsigned char> table = []() {
+            std::vector<unsigned char> values(LINEAR_TO_SRGB_STEPS + 1);
+            for (int i = 0; i <= LINEAR_TO_SRGB_STEPS; ++i) {
+                float linear = static_cast<float>(i) / LINEAR_TO_SRGB_STEPS;
+                float srgb = (linear <= 0.0031308f) ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+                values[i] = static_cast<unsigned char>(std::lround(std::min(std::max(srgb, 0.0f), 1.0f) * 255.0f));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // Zeroth order modified Bessel function of the first kind, used by the Kaiser window
+    float besselI0(float x)
+    {
+        float sum = 1.0f;
+        float term = 1.0f;
+        float halfX = x * 0.5f;
+        for (int k = 1; k < 32; ++k) {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+            if (term < sum * 1e-7f) {
+                break;
+            }
+        }
+        return sum;
+    }
+
+    // Kaiser windowed sinc, distance measured in destination texels
+    float windowedSinc(float distance)
+    {
+        float radius = TextureManager::MIP_FILTER_RADIUS;
+        if (std::fabs(distance) >= radius) {
+            return 0.0f;
+        }
+
+        float sinc = 1.0f;
+        if (distance != 0.0f) {
+            float x = glm::pi<float>() * distance;
+            sinc = std::sin(x) / x;
+        }
+
+        float ratio = distance / radius;
+        float window = besselI0(TextureManager::MIP_FILTER_ALPHA * std::sqrt(1.0f - ratio * ratio)) / besselI0(TextureManager::MIP_FILTER_ALPHA);
+
+        return sinc * window;
+    }
+
+    FilterTaps buildFilterTaps(int sourceSize, int destinationSize)
+    {
+        FilterTaps taps;
+        float scale = static_cast<float>(sourceSize) / static_cast<float>(destinationSize);
+        float support = TextureManager::MIP_FILTER_RADIUS * scale;
+
+        taps.tapCount = static_cast<int>(std::ceil(support)) * 2 + 2;
+        taps.indices.resize(static_cast<size_t>(destinationSize) * taps.tapCount);
+        taps.weights.resize(static_cast<size_t>(destinationSize) * taps.tapCount);
+
+        for (int destination = 0; destination < destinationSize; ++destination) {
+            // Center of the destination texel in source texel coordinates
+            float center = (destination + 0.5f) * scale;
+            int firstSource = static_cast<int>(std::floor(center - support));
+            size_t tapOffset = static_cast<size_t>(destination) * taps.tapCount;
+            float totalWeight = 0.0f;
+
+            for (int tap = 0; tap < taps.tapCount; ++tap) {
+                int source = firstSource + tap;
+                float weight = windowedSinc((source + 0.5f - center) / scale);
+
+                taps.indices[tapOffset + tap] = ((source % sourceSize) + sourceSize) % sourceSize;
+                taps.weights[tapOffset + tap] = weight;
+                totalWeight += weight;
+            }
+
+            // Normalize so flat colors stay flat
+            for (int tap = 0; tap < taps.tapCount; ++tap) {
+                taps.weights[tapOffset + tap] /= totalWeight;
+            }
+        }
+
+        return taps;
+    }
+
+    // destination += source * weight over a full row of floats
+    void accumulateRow(float* destination, const float* source, float weight, size_t count)
+    {
+        size_t i = 0;
+
+#ifdef TEXTURE_MANAGER_SSE
+        __m128 weights = _mm_set1_ps(weight);
+        for (; i + 4 <= count; i += 4) {
+            __m128 accumulated = _mm_loadu_ps(destination + i);
+            __m128 sourceValues = _mm_loadu_ps(source + i);
+            _mm_storeu_ps(destination + i, _mm_add_ps(accumulated, _mm_mul_ps(sourceValues, weights)));
+        }
+#endif
+
+        for (; i < count; ++i) {
+            destination[i] += source[i] * weight;
+        }
+    }
+
+    int64_t getWriteTime(const std::string& filename, bool& found)
+    {
+        std::error_code error;
+        int64_t writeTime = static_cast<int64_t>(std::filesystem::last_write_time(std::filesystem::path(filename), error).time_since_epoch().count());
+        found = !error;
+        return writeTime;
+    }
+
+    // 64 bit FNV-1a hash of the bytes of a file
+    bool hashFile(const std::string& filename, uint64_t& hash)
+    {
+        MappedFile file;
+        if (!file.open(filename)) {
+            return false;
+        }
+
+        hash = 14695981039346656037ull;
+        const unsigned char* bytes = file.getData();
+        for (size_t i = 0; i < file.getSize(); ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return true;
+    }
+
+    // Parse the cache file name back into the key it was named by
+    bool parseCacheKey(const std::string& cacheFilename, uint64_t& sourceHash, int64_t& sourceWriteTime)
+    {
+        std::string stem = std::filesystem::path(cacheFilename).stem().string();
+        size_t separator = stem.find('-');
+        if (separator == std::string::npos) {
+            return false;
+        }
+
+        sourceHash = std::stoull(stem.substr(0, separator), nullptr, 16);
+        sourceWriteTime = static_cast<int64_t>(std::stoull(stem.substr(separator + 1), nullptr, 16));
+        return true;
+    }
+
+    // Map the mip cache file and validate its header and level table against the file size and key
+    bool mapMipCache(const std::string& cacheFilename, std::shared_ptr<MappedFile>& mappedFile, MipCacheHeader& header,
+        std::vector<MipCacheLevel>& levelEntries, const unsigned char*& pixelData)
+    {
+        uint64_t sourceHash;
+        int64_t sourceWriteTime;
+        if (!parseCacheKey(cacheFilename, sourceHash, sourceWriteTime)) {
+            return false;
+        }
+
+        mappedFile = std::make_shared<MappedFile>();
+        if (!mappedFile->open(cacheFilename) || mappedFile->getSize() < sizeof(MipCacheHeader)) {
+            return false;
+        }
+
+        // The header and level table are copied out, the writer does not align the table for in place reads
+        std::memcpy(&header, mappedFile->getData(), sizeof(header));
+        if (header.magic != MIP_CACHE_MAGIC || header.version != MIP_CACHE_VERSION
+            || header.sourceHash != sourceHash || header.sourceWriteTime != sourceWriteTime
+            || (header.channels != 3 && header.channels != 4) || header.levelCount <= 0) {
+            return false;
+        }
+
+        size_t tableEnd = sizeof(MipCacheHeader) + sizeof(MipCacheLevel) * header.levelCount;
+        if (mappedFile->getSize() < tableEnd) {
+            return false;
+        }
+        levelEntries.resize(header.levelCount);
+        std::memcpy(levelEntries.data(), mappedFile->getData() + sizeof(MipCacheHeader), sizeof(MipCacheLevel) * header.levelCount);
+        pixelData = mappedFile->getData() + tableEnd;
+
+        // Reject corrupt or truncated levels before glTexImage2D reads their dimensions past the end of the mapping
+        uint64_t remainingBytes = mappedFile->getSize() - tableEnd;
+        for (const MipCacheLevel& levelEntry : levelEntries) {
+            if (levelEntry.width <= 0 || levelEntry.height <= 0
+                || levelEntry.byteSize != static_cast<uint64_t>(levelEntry.width) * levelEntry.height * header.channels
+                || levelEntry.byteSize > remainingBytes) {
+                return false;
+            }
+            remainingBytes -= levelEntry.byteSize;
+        }
+        return true;
+    }
+}
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// ######################
+// # Singleton Instance #
+// ######################
+
+
+TextureManager& TextureManager::getInstance()
+{
+    static TextureManager instance;
+    return instance;
+}
+
+
+// ##################
+// # Getter methods #
+// ##################
+
+
+const TextureLoadStats TextureManager::getLoadStats() const
+{
+    return loadStats;
+}
+
+
+// ##################
+// # Setter methods #
+// ##################
+
+
+void TextureManager::setCacheDirectory(const std::string& cacheDirectory)
+{
+    this->cacheDirectory = cacheDirectory;
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+bool TextureManager::createTexture(const char* filename, GLuint& textureId)
+{
+    // Reuse the texture if the image was already loaded
+    auto cachedTexture = textureCache.find(filename);
+    if (cachedTexture != textureCache.end()) {
+        textureId = cachedTexture->second.textureId;
+        return true;
+    }
+
+    // Map the cooked mip chain, cook it if the cache has no entry for the image
+    auto loadStart = std::chrono::steady_clock::now();
+    MipChain mipChain;
+    bool warmLoad = readMipCache(filename, mipChain);
+    if (!warmLoad && !cookTexture(filename, mipChain)) {
+        // Error loading the image
+        return false;
+    }
+    double loadMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+
+    if (warmLoad) {
+        ++loadStats.warmLoads;
+        loadStats.warmMilliseconds += loadMilliseconds;
+        loadStats.warmCookMilliseconds += mipChain.cookMilliseconds;
+    }
+    else {
+        ++loadStats.coldLoads;
+        loadStats.coldMilliseconds += loadMilliseconds;
+    }
+
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+
+    // set the texture wrapping parameters
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    // set texture filtering parameters, sampling between the precomputed mip levels
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    uploadMipChain(textureId, mipChain);
+
+    glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+    textureCache[filename] = { textureId, mipChain.levels[0].width, mipChain.levels[0].height, mipChain.channels, static_cast<int>(mipChain.levels.size()) };
+    TextureResidencyManager::getInstance().registerTexture(textureId, GL_TEXTURE_2D, { filename }, mipChain.levels[0].width, mipChain.levels[0].height, mipChain.channels, static_cast<int>(mipChain.levels.size()));
+
+    return true;
+}
+
+bool TextureManager::cookTexture(const char* filename, MipChain& mipChain)
+{
+    auto cookStart = std::chrono::steady_clock::now();
+    int width, height, channels;
+    unsigned char* image = stbi_load(filename, &width, &height, &channels, 0);
+    if (!image) {
+        return false;
+    }
+
+    if (channels != 3 && channels != 4) {
+        cout << "Not implemented to handle image with " << channels << " channels" << endl;
+        stbi_image_free(image);
+        return false;
+    }
+
+    flipImageVertically(image, width, height, channels);
+
+    mipChain.channels = channels;
+    mipChain.levels.clear();
+    mipChain.levels.resize(1);
+    mipChain.levels[0].width = width;
+    mipChain.levels[0].height = height;
+    mipChain.levels[0].pixels.assign(image, image + static_cast<size_t>(width) * height * channels);
+
+    stbi_image_free(image);
+
+    generateMipLevels(mipChain);
+    mipChain.cookMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cookStart).count();
+
+    if (!writeMipCache(filename, mipChain)) {
+        cout << "WARNING: Unable to write mip cache for " << filename << endl;
+    }
+
+    return true;
+}
+
+void TextureManager::uploadMipChain(GLuint textureId, const MipChain& mipChain, int firstLevel)
+{
+    GLenum internalFormat = (mipChain.channels == 4) ? GL_RGBA8 : GL_RGB8;
+    GLenum format = (mipChain.channels == 4) ? GL_RGBA : GL_RGB;
+    int lastLevel = static_cast<int>(mipChain.levels.size()) - 1;
+    firstLevel = std::max(0, std::min(firstLevel, lastLevel));
+
+    glBindTexture(GL_TEXTURE_2D, textureId);
+
+    // Levels are tightly packed, RGB rows of odd widths are not 4 byte aligned
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, lastLevel);
+
+    // Coarsest level first so a partially uploaded chain is already complete from its base level down
+    for (int level = lastLevel; level >= firstLevel; --level) {
+        const MipLevel& mipLevel = mipChain.levels[level];
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat, mipLevel.width, mipLevel.height, 0, format, GL_UNSIGNED_BYTE, mipLevel.data());
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, firstLevel);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void TextureManager::packTextureArrays()
+{
+    // Group the textures by everything an array needs to share (size, channels, and so level count)
+    std::map<std::tuple<int, int, int>, std::vector<std::string>> textureGroups;
+    for (const auto& cachedTexture : textureCache) {
+        const TextureInfo& textureInfo = cachedTexture.second;
+        if (textureArrayLayers.count(textureInfo.textureId) == 0) {
+            textureGroups[std::make_tuple(textureInfo.width, textureInfo.height, textureInfo.channels)].push_back(cachedTexture.first);
+        }
+    }
+
+    for (const auto& textureGroup : textureGroups) {
+        const std::vector<std::string>& filenames = textureGroup.second;
+        const TextureInfo& groupInfo = textureCache[filenames[0]];
+        GLenum internalFormat = (groupInfo.channels == 4) ? GL_RGBA8 : GL_RGB8;
+        GLenum format = (groupInfo.channels == 4) ? GL_RGBA : GL_RGB;
+
+        GLuint arrayTextureId;
+        glGenTextures(1, &arrayTextureId);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, arrayTextureId);
+        // Mutable storage so the residency manager can release levels
+        for (int level = 0; level < groupInfo.levelCount; ++level) {
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, std::max(1, groupInfo.width >> level), std::max(1, groupInfo.height >> level),
+                static_cast<GLsizei>(filenames.size()), 0, format, GL_UNSIGNED_BYTE, NULL);
+        }
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, groupInfo.levelCount - 1);
+
+        // Same sampling as the GL_TEXTURE_2D textures
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+        // Copy the uploaded levels on the GPU, then the GL_TEXTURE_2D texture would only duplicate its layer
+        for (size_t layer = 0; layer < filenames.size(); ++layer) {
+            GLuint textureId = textureCache[filenames[layer]].textureId;
+            for (int level = 0; level < groupInfo.levelCount; ++level) {
+                glCopyImageSubData(textureId, GL_TEXTURE_2D, level, 0, 0, 0, arrayTextureId, GL_TEXTURE_2D_ARRAY, level, 0, 0, static_cast<GLint>(layer),
+                    std::max(1, groupInfo.width >> level), std::max(1, groupInfo.height >> level), 1);
+            }
+            glDeleteTextures(1, &textureId);
+            TextureResidencyManager::getInstance().unregisterTexture(textureId);
+
+            textureArrayLayers[textureId] = { arrayTextureId, static_cast<int>(layer) };
+        }
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        textureArrayIds.push_back(arrayTextureId);
+        TextureResidencyManager::getInstance().registerTexture(arrayTextureId, GL_TEXTURE_2D_ARRAY, filenames, groupInfo.width, groupInfo.height, groupInfo.channels, groupInfo.levelCount);
+
+        cout << "INFO: Packed " << filenames.size() << " " << groupInfo.width << "x" << groupInfo.height << " textures in texture array " << arrayTextureId << endl;
+    }
+}
+
+bool TextureManager::getTextureArrayLayer(GLuint textureId, TextureArrayLayer& arrayLayer) const
+{
+    auto packedLayer = textureArrayLayers.find(textureId);
+    if (packedLayer == textureArrayLayers.end()) {
+        return false;
+    }
+
+    arrayLayer = packedLayer->second;
+    return true;
+}
+
+bool TextureManager::loadMipLevel(const char* filename, int level, MipLevel& mipLevel)
+{
+    if (readMipCacheLevel(filename, level, mipLevel)) {
+        return true;
+    }
+
+    // Cache is missing or stale, cook the whole chain and keep the requested level
+    MipChain mipChain;
+    if (!cookTexture(filename, mipChain) || level < 0 || level >= static_cast<int>(mipChain.levels.size())) {
+        return false;
+    }
+
+    mipLevel = std::move(mipChain.levels[level]);
+    return true;
+}
+
+bool TextureManager::isBindlessSupported() const
+{
+    return GLEW_ARB_bindless_texture;
+}
+
+bool TextureManager::makeTexturesResident()
+{
+    if (!isBindlessSupported()) {
+        return false;
+    }
+
+    for (const auto& cachedTexture : textureCache) {
+        GLuint textureId = cachedTexture.second.textureId;
+        if (textureHandles.count(textureId) > 0) {
+            continue;
+        }
+
+        GLuint64 handle = glGetTextureHandleARB(textureId);
+        if (handle == 0) {
+            cout << "Failed to create bindless handle for texture " << cachedTexture.first << endl;
+            return false;
+        }
+
+        glMakeTextureHandleResidentARB(handle);
+        textureHandles[textureId] = handle;
+
+        // The texture's levels are frozen once it has a handle
+        TextureResidencyManager::getInstance().pinTexture(textureId);
+    }
+
+    return true;
+}
+
+bool TextureManager::getTextureHandle(GLuint textureId, GLuint64& handle) const
+{
+    auto residentHandle = textureHandles.find(textureId);
+    if (residentHandle == textureHandles.end()) {
+        return false;
+    }
+
+    handle = residentHandle->second;
+    return true;
+}
+
+void TextureManager::destroyTextures()
+{
+    // Resident textures can not be deleted
+    for (const auto& residentHandle : textureHandles) {
+        glMakeTextureHandleNonResidentARB(residentHandle.second);
+    }
+    textureHandles.clear();
+
+    for (const auto& cachedTexture : textureCache) {
+        // Packed textures were already deleted, their ids only select an array layer
+        if (textureArrayLayers.count(cachedTexture.second.textureId) == 0) {
+            glDeleteTextures(1, &cachedTexture.second.textureId);
+        }
+    }
+    textureCache.clear();
+
+    if (!textureArrayIds.empty()) {
+        glDeleteTextures(static_cast<GLsizei>(textureArrayIds.size()), textureArrayIds.data());
+    }
+    textureArrayIds.clear();
+    textureArrayLayers.clear();
+
+    TextureResidencyManager::getInstance().unregisterTextures();
+}
+
+
+// ###################
+// #                 #
+// # Private methods #
+// #                 #
+// ###################
+
+
+// ################
+// # Constructors #
+// ################
+
+
+TextureManager::TextureManager() : cacheDirectory(DEFAULT_CACHE_DIRECTORY) {}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+bool TextureManager::loadMipChain(const char* filename, MipChain& mipChain)
+{
+    // Load the cooked mip chain, cook it if the cache is missing or stale
+    return readMipCache(filename, mipChain) || cookTexture(filename, mipChain);
+}
+
+void TextureManager::flipImageVertically(unsigned char* image, int width, int height, int channels)
+{
+    for (int j = 0; j < height / 2; ++j)
+    {
+        int index1 = j * width * channels;
+        int index2 = (height - 1 - j) * width * channels;
+
+        for (int i = width * channels; i > 0; --i)
+        {
+            unsigned char tmp = image[index1];
+            image[index1] = image[index2];
+            image[index2] = tmp;
+            ++index1;
+            ++index2;
+        }
+    }
+}
+
+void TextureManager::generateMipLevels(MipChain& mipChain)
+{
+    ThreadPool& threadPool = ThreadPool::getInstance();
+    const std::vector<float>& srgbToLinear = getSrgbToLinearTable();
+    const std::vector<unsigned char>& linearToSrgb = getLinearToSrgbTable();
+
+    int channels = mipChain.channels;
+    int width = mipChain.levels[0].width;
+    int height = mipChain.levels[0].height;
+    mipChain.levels.resize(1);
+
+    // Decode level 0 to linear space once, every following level is filtered from the previous float level
+    // Alpha (channel 4) is not gamma encoded
+    std::vector<float> current(static_cast<size_t>(width) * height * channels);
+    const std::vector<unsigned char>& basePixels = mipChain.levels[0].pixels;
+    threadPool.parallelFor(current.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            current[i] = (i % channels == 3) ? basePixels[i] / 255.0f : srgbToLinear[basePixels[i]];
+        }
+    });
+
+    while (width > 1 || height > 1) {
+        int nextWidth = std::max(1, width / 2);
+        int nextHeight = std::max(1, height / 2);
+        FilterTaps columnTaps = buildFilterTaps(width, nextWidth);
+        FilterTaps rowTaps = buildFilterTaps(height, nextHeight);
+
+        // Horizontal pass, shrink every row from width to nextWidth
+        std::vector<float> horizontal(static_cast<size_t>(nextWidth) * height * channels);
+        threadPool.parallelFor(height, [&](size_t rowBegin, size_t rowEnd) {
+            for (size_t row = rowBegin; row < rowEnd; ++row) {
+                const float* sourceRow = current.data() + row * width * channels;
+                float* destinationRow = horizontal.data() + row * nextWidth * channels;
+
+                for (int column = 0; column < nextWidth; ++column) {
+                    size_t tapOffset = static_cast<size_t>(column) * columnTaps.tapCount;
+                    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+                    for (int tap = 0; tap < columnTaps.tapCount; ++tap) {
+                        const float* sourceTexel = sourceRow + static_cast<size_t>(columnTaps.indices[tapOffset + tap]) * channels;
+                        float weight = columnTaps.weights[tapOffset + tap];
+                        for (int channel = 0; channel < channels; ++channel) {
+                            sum[channel] += sourceTexel[channel] * weight;
+                        }
+                    }
+
+                    for (int channel = 0; channel < channels; ++channel) {
+                        destinationRow[column * channels + channel] = sum[channel];
+                    }
+                }
+            }
+        });
+
+        // Vertical pass, whole rows are weighted and summed so the inner loop runs 4 floats at a time
+        size_t rowFloats = static_cast<size_t>(nextWidth) * channels;
+        std::vector<float> next(rowFloats * nextHeight, 0.0f);
+        threadPool.parallelFor(nextHeight, [&](size_t rowBegin, size_t rowEnd) {
+            for (size_t row = rowBegin; row < rowEnd; ++row) {
+                size_t tapOffset = row * rowTaps.tapCount;
+                float* destinationRow = next.data() + row * rowFloats;
+
+                for (int tap = 0; tap < rowTaps.tapCount; ++tap) {
+                    float weight = rowTaps.weights[tapOffset + tap];
+                    if (weight != 0.0f) {
+                        const float* sourceRow = horizontal.data() + static_cast<size_t>(rowTaps.indices[tapOffset + tap]) * rowFloats;
+                        accumulateRow(destinationRow, sourceRow, weight, rowFloats);
+                    }
+                }
+            }
+        });
+
+        // Encode the level back to 8 bit sRGB for storage and upload
+        MipLevel level;
+        level.width = nextWidth;
+        level.height = nextHeight;
+        level.pixels.resize(next.size());
+        threadPool.parallelFor(next.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                float value = std::min(std::max(next[i], 0.0f), 1.0f);
+                if (i % channels == 3) {
+                    level.pixels[i] = static_cast<unsigned char>(value * 255.0f + 0.5f);
+                }
+                else {
+                    level.pixels[i] = linearToSrgb[static_cast<size_t>(value * LINEAR_TO_SRGB_STEPS + 0.5f)];
+                }
+            }
+        });
+        mipChain.levels.push_back(std::move(level));
+
+        current.swap(next);
+        width = nextWidth;
+        height = nextHeight;
+    }
+}
+
+bool TextureManager::getCacheFilename(const std::string& filename, std::string& cacheFilename)
+{
+    bool found;
+    int64_t writeTime = getWriteTime(filename, found);
+    if (!found) {
+        return false;
+    }
+
+    // Only rehash the image when it was written since the last lookup
+    auto cached = cacheFilenames.find(filename);
+    if (cached != cacheFilenames.end() && cached->second.first == writeTime) {
+        cacheFilename = cached->second.second;
+        return true;
+    }
+
+    uint64_t hash;
+    if (!hashFile(filename, hash)) {
+        return false;
+    }
+
+    std::ostringstream name;
+    name << std::hex << std::setfill('0') << std::setw(16) << hash << "-" << std::setw(16) << static_cast<uint64_t>(writeTime) << MIP_CACHE_EXTENSION;
+    cacheFilename = (std::filesystem::path(cacheDirectory) / name.str()).string();
+    cacheFilenames[filename] = { writeTime, cacheFilename };
+
+    return true;
+}
+
+bool TextureManager::readMipCache(const std::string& filename, MipChain& mipChain)
+{
+    std::string cacheFilename;
+    std::shared_ptr<MappedFile> mappedFile;
+    MipCacheHeader header;
+    std::vector<MipCacheLevel> levelEntries;
+    const unsigned char* pixelData;
+    if (!getCacheFilename(filename, cacheFilename) || !mapMipCache(cacheFilename, mappedFile, header, levelEntries, pixelData)) {
+        return false;
+    }
+
+    // Levels point straight into the mapping, the pixels are never copied before upload
+    mipChain.channels = header.channels;
+    mipChain.cookMilliseconds = header.cookMilliseconds;
+    mipChain.levels.resize(header.levelCount);
+    for (int i = 0; i < header.levelCount; ++i) {
+        MipLevel& level = mipChain.levels[i];
+        level.width = levelEntries[i].width;
+        level.height = levelEntries[i].height;
+        level.pixels.clear();
+        level.mappedPixels = pixelData;
+        level.mappedSize = static_cast<size_t>(levelEntries[i].byteSize);
+        level.mappedFile = mappedFile;
+
+        pixelData += levelEntries[i].byteSize;
+    }
+
+    return true;
+}
+
+bool TextureManager::readMipCacheLevel(const std::string& filename, int level, MipLevel& mipLevel)
+{
+    std::string cacheFilename;
+    std::shared_ptr<MappedFile> mappedFile;
+    MipCacheHeader header;
+    std::vector<MipCacheLevel> levelEntries;
+    const unsigned char* pixelData;
+    if (!getCacheFilename(filename, cacheFilename) || !mapMipCache(cacheFilename, mappedFile, header, levelEntries, pixelData)
+        || level < 0 || level >= header.levelCount) {
+        return false;
+    }
+
+    // Skip the pixels of the finer levels
+    for (int i = 0; i < level; ++i) {
+        pixelData += levelEntries[i].byteSize;
+    }
+
+    mipLevel.width = levelEntries[level].width;
+    mipLevel.height = levelEntries[level].height;
+    mipLevel.pixels.clear();
+    mipLevel.mappedPixels = pixelData;
+    mipLevel.mappedSize = static_cast<size_t>(levelEntries[level].byteSize);
+    mipLevel.mappedFile = mappedFile;
+
+    return true;
+}
+
+bool TextureManager::writeMipCache(const std::string& filename, const MipChain& mipChain)
+{
+    std::string cacheFilename;
+    if (!getCacheFilename(filename, cacheFilename)) {
+        return false;
+    }
+
+    MipCacheHeader header;
+    if (!parseCacheKey(cacheFilename, header.sourceHash, header.sourceWriteTime)) {
+        return false;
+    }
+
+    header.magic = MIP_CACHE_MAGIC;
+    header.version = MIP_CACHE_VERSION;
+    header.channels = mipChain.channels;
+    header.levelCount = static_cast<int32_t>(mipChain.levels.size());
+    header.cookMilliseconds = mipChain.cookMilliseconds;
+
+    std::vector<MipCacheLevel> levelEntries;
+    for (const MipLevel& level : mipChain.levels) {
+        levelEntries.push_back({ level.width, level.height, level.size() });
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
+
+    std::ofstream cacheFile(cacheFilename, std::ios::binary | std::ios::trunc);
+    if (!cacheFile) {
+        return false;
+    }
+
+    cacheFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    cacheFile.write(reinterpret_cast<const char*>(levelEntries.data()), sizeof(MipCacheLevel) * levelEntries.size());
+    for (const MipLevel& level : mipChain.levels) {
+        cacheFile.write(reinterpret_cast<const char*>(level.data()), level.size());
+    }
+
+    return static_cast<bool>(cacheFile);
+}
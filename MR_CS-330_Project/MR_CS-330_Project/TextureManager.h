@@ -1,57 +1,325 @@
-//// TextureManager.h
-//#pragma once
-//
-//#include <iostream>         // cout, cerr
-//#include <cstdlib>          // EXIT_FAILURE
-//#include <GL/glew.h>
-//
-//#define STB_IMAGE_IMPLEMENTATION    
-//#include <stb_image.h>
-//
-///**
-// * Class representing a CubeMesh object with transformations.
-// */
-//class TextureManager {
-//public:
-//    // ######################
-//    // # Singleton Instance #
-//    // ######################
-//
-//
-//    /**
-//     * Get the Texture Manager Singleton Instance     *
-//     */
-//    static TextureManager& getInstance();
-//
-//    // Prevent copying and assignment
-//    TextureManager(const TextureManager&) = delete;
-//    void operator=(const TextureManager&) = delete;
-//
-//
-//    // #################
-//    // # Other methods #
-//    // #################
-//
-//    // 
-//    bool createTexture(const char* filename, GLuint& textureId);
-//
-//private:
-//    // ################
-//    // # Constructors #
-//    // ################
-//
-//
-//    /**
-//     * TextureManager constructor.
-//     */
-//    TextureManager();
-//
-//
-//    // #################
-//    // # Other methods #
-//    // #################
-//
-//
-//    // Images are loaded with Y axis going down, but OpenGL's Y axis goes up, so let's flip it
-//    void flipImageVertically(unsigned char* image, int width, int height, int channels);
-//};
+// TextureManager.h
+#pragma once
+
+#include "MappedFile.h"
+#include <GL/glew.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Struct representing a single level of a texture mip chain.
+ * Pixels are tightly packed (no row padding), either owned after cooking or pointing into the mapped mip cache.
+ */
+struct MipLevel {
+    int width;                                      // Width of the level in texels
+    int height;                                     // Height of the level in texels
+    std::vector<unsigned char> pixels;              // Owned pixel data, empty when the level is mapped
+    const unsigned char* mappedPixels = nullptr;    // Pixel data in the mapped mip cache
+    size_t mappedSize = 0;                          // Byte size of the mapped pixel data
+    std::shared_ptr<MappedFile> mappedFile;         // Keeps the mip cache mapped while the level points into it
+
+    /**
+     * Get the pixel data of the level, wherever it is stored.
+     *
+     * @return Pointer to the first pixel.
+     */
+    const unsigned char* data() const { return mappedPixels ? mappedPixels : pixels.data(); }
+
+    /**
+     * Get the byte size of the pixel data of the level.
+     *
+     * @return The byte size.
+     */
+    size_t size() const { return mappedPixels ? mappedSize : pixels.size(); }
+};
+
+/**
+ * Struct representing a full texture mip chain, level 0 being the full resolution image.
+ */
+struct MipChain {
+    int channels;                       // Number of channels per texel (3 = RGB, 4 = RGBA)
+    std::vector<MipLevel> levels;       // Levels from full resolution down to 1x1
+    double cookMilliseconds = 0.0;      // Time spent decoding and filtering the chain when it was cooked
+};
+
+/**
+ * Struct representing how long textures took to load, split by mip cache hits (warm) and misses (cold).
+ */
+struct TextureLoadStats {
+    int warmLoads = 0;                  // Textures mapped from the mip cache
+    int coldLoads = 0;                  // Textures decoded and cooked
+    double warmMilliseconds = 0.0;      // Time spent loading warm textures
+    double coldMilliseconds = 0.0;      // Time spent loading cold textures
+    double warmCookMilliseconds = 0.0;  // Time the warm textures took when they were cooked cold
+};
+
+/**
+ * Struct representing a texture created by the manager.
+ */
+struct TextureInfo {
+    GLuint textureId;                   // GL_TEXTURE_2D id of the texture
+    int width;                          // Width of level 0 in texels
+    int height;                         // Height of level 0 in texels
+    int channels;                       // Number of channels per texel (3 = RGB, 4 = RGBA)
+    int levelCount;                     // Number of mip levels
+};
+
+/**
+ * Struct representing where a texture was packed in a texture array.
+ */
+struct TextureArrayLayer {
+    GLuint arrayTextureId;              // GL_TEXTURE_2D_ARRAY id holding the texture
+    int layer;                          // Layer index of the texture in the array
+};
+
+/**
+ * Class representing the manager for loading, cooking, and caching textures.
+ */
+class TextureManager {
+public:
+    // ######################
+    // # Singleton Instance #
+    // ######################
+
+
+    /**
+     * Get the Texture Manager Singleton Instance
+     */
+    static TextureManager& getInstance();
+
+    // Prevent copying and assignment
+    TextureManager(const TextureManager&) = delete;
+    void operator=(const TextureManager&) = delete;
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the load times of the textures created so far.
+     *
+     * @return The load stats.
+     */
+    const TextureLoadStats getLoadStats() const;
+
+
+    // ##################
+    // # Setter methods #
+    // ##################
+
+
+    /**
+     * Set the directory the mip cache files are stored in.
+     * Cache files are named by the hash of the image contents and its write time, so identical
+     * images share a cache file and edited images get a new one.
+     *
+     * @param cacheDirectory Path of the cache directory, created when the first file is written.
+     */
+    void setCacheDirectory(const std::string& cacheDirectory);
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Create a texture from an image file in the provided textureId reference.
+     * The mip chain is mapped from the mip cache, cooking it first if the cache has no entry
+     * for the image. Textures already created from the same file are reused.
+     *
+     * @param filename Path of the image file.
+     * @param textureId Reference to create the texture id in.
+     * @return True if the texture was created.
+     */
+    bool createTexture(const char* filename, GLuint& textureId);
+
+    /**
+     * Cook the mip chain for an image file and write it to the mip cache.
+     *
+     * @param filename Path of the image file.
+     * @param mipChain Reference to store the cooked mip chain in.
+     * @return True if the image was loaded and cooked.
+     */
+    bool cookTexture(const char* filename, MipChain& mipChain);
+
+    /**
+     * Upload the levels of a mip chain to a texture, coarsest level first.
+     * Levels finer than firstLevel are left out so they can be streamed in later by uploading again
+     * with a lower firstLevel, the texture stays complete after each call.
+     *
+     * @param textureId The texture to upload to.
+     * @param mipChain The mip chain to upload.
+     * @param firstLevel The finest level to upload.
+     */
+    void uploadMipChain(GLuint textureId, const MipChain& mipChain, int firstLevel = 0);
+
+    /**
+     * Pack every texture created so far into GL_TEXTURE_2D_ARRAY textures, one array per texture size
+     * and channel count, so draws can select a layer with a uniform instead of rebinding textures.
+     * The levels are copied on the GPU and the GL_TEXTURE_2D textures are deleted, their ids keep selecting
+     * their layer. Textures created afterwards stay GL_TEXTURE_2D textures.
+     */
+    void packTextureArrays();
+
+    /**
+     * Get the texture array and layer a texture was packed in.
+     *
+     * @param textureId The GL_TEXTURE_2D id of the texture.
+     * @param arrayLayer Reference to store the texture array and layer in.
+     * @return True if the texture was packed in a texture array.
+     */
+    bool getTextureArrayLayer(GLuint textureId, TextureArrayLayer& arrayLayer) const;
+
+    /**
+     * Load a single level of the mip chain of an image file from the mip cache, for streaming levels in.
+     *
+     * @param filename Path of the image file.
+     * @param level The mip level to load.
+     * @param mipLevel Reference to store the level in.
+     * @return True if the level was loaded.
+     */
+    bool loadMipLevel(const char* filename, int level, MipLevel& mipLevel);
+
+    /**
+     * Check if the driver supports GL_ARB_bindless_texture.
+     *
+     * @return True if bindless texture handles can be used.
+     */
+    bool isBindlessSupported() const;
+
+    /**
+     * Create a bindless handle for every texture created so far and make it resident.
+     * Once a texture has a handle its sampling state and storage can no longer change.
+     *
+     * @return True if every texture has a resident handle.
+     */
+    bool makeTexturesResident();
+
+    /**
+     * Get the resident bindless handle of a texture.
+     *
+     * @param textureId The GL_TEXTURE_2D id of the texture.
+     * @param handle Reference to store the handle in.
+     * @return True if the texture has a resident handle.
+     */
+    bool getTextureHandle(GLuint textureId, GLuint64& handle) const;
+
+    /**
+     * Delete every texture and texture array created by the manager, releasing resident handles first.
+     */
+    void destroyTextures();
+
+
+    // #############
+    // # Variables #
+    // #############
+
+
+    // Class constants
+    static constexpr const char* MIP_CACHE_EXTENSION = ".mipcache";
+    static constexpr const char* DEFAULT_CACHE_DIRECTORY = "texture_cache";
+    static constexpr float MIP_FILTER_RADIUS = 3.0f;    // Kaiser windowed sinc radius in destination texels
+    static constexpr float MIP_FILTER_ALPHA = 4.0f;     // Kaiser window shape (greater = smoother, less ringing)
+
+private:
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * TextureManager constructor.
+     */
+    TextureManager();
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Load the mip chain of an image file from the mip cache, cooking it first if the cache is missing or stale.
+     *
+     * @param filename Path of the image file.
+     * @param mipChain Reference to store the mip chain in.
+     * @return True if the mip chain was loaded.
+     */
+    bool loadMipChain(const char* filename, MipChain& mipChain);
+
+    /**
+     * Images are loaded with Y axis going down, but OpenGL's Y axis goes up, so flip it
+     *
+     * @param image The image pixel data.
+     * @param width The width of the image.
+     * @param height The height of the image.
+     * @param channels The number of channels per pixel.
+     */
+    void flipImageVertically(unsigned char* image, int width, int height, int channels);
+
+    /**
+     * Generate every level below level 0 of the mip chain.
+     * Filtering is done in linear space (gamma-correct) with a separable Kaiser windowed sinc filter,
+     * each pass is split into row bands across the thread pool.
+     *
+     * @param mipChain The mip chain holding level 0 to generate the remaining levels for.
+     */
+    void generateMipLevels(MipChain& mipChain);
+
+    /**
+     * Get the path of the mip cache file of an image, keyed by the hash of its contents and its write time.
+     * The hash is only recomputed when the write time changes.
+     *
+     * @param filename Path of the image file.
+     * @param cacheFilename Reference to store the cache file path in.
+     * @return True if the image could be read.
+     */
+    bool getCacheFilename(const std::string& filename, std::string& cacheFilename);
+
+    /**
+     * Map a cooked mip chain from the mip cache, the levels point into the mapped file.
+     *
+     * @param filename Path of the image file the cache belongs to.
+     * @param mipChain Reference to store the mip chain in.
+     * @return True if the cache has an entry for the image.
+     */
+    bool readMipCache(const std::string& filename, MipChain& mipChain);
+
+    /**
+     * Map a single level of a cooked mip chain from the mip cache.
+     *
+     * @param filename Path of the image file the cache belongs to.
+     * @param level The mip level to read.
+     * @param mipLevel Reference to store the level in.
+     * @return True if the cache has an entry for the image with the level.
+     */
+    bool readMipCacheLevel(const std::string& filename, int level, MipLevel& mipLevel);
+
+    /**
+     * Write a cooked mip chain to the mip cache.
+     *
+     * @param filename Path of the image file the cache belongs to.
+     * @param mipChain The mip chain to write.
+     * @return True if the cache was written.
+     */
+    bool writeMipCache(const std::string& filename, const MipChain& mipChain);
+
+
+    // #############
+    // # Variables #
+    // #############
+
+    std::map<std::string, TextureInfo> textureCache;            // Created textures by image file path
+    std::map<GLuint, TextureArrayLayer> textureArrayLayers;     // Packed array layers by texture id
+    std::vector<GLuint> textureArrayIds;                        // Created texture array ids
+    std::map<GLuint, GLuint64> textureHandles;                  // Resident bindless handles by texture id
+    std::string cacheDirectory;                                 // Directory of the mip cache files
+    std::map<std::string, std::pair<int64_t, std::string>> cacheFilenames;  // Write time and cache file path by image file path
+    TextureLoadStats loadStats;                                 // Load times of the created textures
+};
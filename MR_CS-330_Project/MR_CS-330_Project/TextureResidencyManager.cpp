@@ -0,0 +1,329 @@
+#include "TextureResidencyManager.h"
+#include "TextureManager.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>         // cout, cerr
+
+using namespace std;
+
+// Unnamed namespace
+namespace
+{
+    // Drivers keep RGB8 textures padded to 4 bytes per texel
+    const size_t BYTES_PER_TEXEL = 4;
+
+    GLenum getBindingQuery(GLenum target)
+    {
+        return (target == GL_TEXTURE_2D_ARRAY) ? GL_TEXTURE_BINDING_2D_ARRAY : GL_TEXTURE_BINDING_2D;
+    }
+}
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// ######################
+// # Singleton Instance #
+// ######################
+
+
+TextureResidencyManager& TextureResidencyManager::getInstance()
+{
+    static TextureResidencyManager instance;
+    return instance;
+}
+
+
+// ##################
+// # Getter methods #
+// ##################
+
+
+const size_t TextureResidencyManager::getBudget() const
+{
+    return budgetBytes;
+}
+
+const size_t TextureResidencyManager::getResidentBytes() const
+{
+    return residentBytes;
+}
+
+const size_t TextureResidencyManager::getStreamedBytes() const
+{
+    return streamedBytes;
+}
+
+const size_t TextureResidencyManager::getEvictedBytes() const
+{
+    return evictedBytes;
+}
+
+
+// ##################
+// # Setter methods #
+// ##################
+
+
+void TextureResidencyManager::setBudget(size_t budgetBytes)
+{
+    this->budgetBytes = budgetBytes;
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+void TextureResidencyManager::registerTexture(GLuint textureId, GLenum target, const std::vector<std::string>& filenames, int width, int height, int channels, int levelCount)
+{
+    ResidentTexture residentTexture;
+    residentTexture.target = target;
+    residentTexture.filenames = filenames;
+    residentTexture.width = width;
+    residentTexture.height = height;
+    residentTexture.channels = channels;
+    residentTexture.baseLevel = 0;
+    residentTexture.coarsestBaseLevel = levelCount - 1;
+    residentTexture.lastUsedFrame = 0;
+    residentTexture.pinned = false;
+
+    for (int level = 0; level < levelCount; ++level) {
+        int levelWidth = std::max(1, width >> level);
+        int levelHeight = std::max(1, height >> level);
+        residentTexture.levelBytes.push_back(static_cast<size_t>(levelWidth) * levelHeight * BYTES_PER_TEXEL * filenames.size());
+
+        // Small levels cost little and keep the texture drawable at any distance
+        if (levelWidth <= MIN_RESIDENT_SIZE && levelHeight <= MIN_RESIDENT_SIZE) {
+            residentTexture.coarsestBaseLevel = std::min(residentTexture.coarsestBaseLevel, level);
+        }
+    }
+    residentTexture.requiredLevel = residentTexture.coarsestBaseLevel;
+
+    // Every level is uploaded when the texture is created
+    for (size_t bytes : residentTexture.levelBytes) {
+        residentBytes += bytes;
+    }
+
+    residentTextures[textureId] = residentTexture;
+}
+
+void TextureResidencyManager::pinTexture(GLuint textureId)
+{
+    auto residentTexture = residentTextures.find(textureId);
+    if (residentTexture != residentTextures.end()) {
+        residentTexture->second.pinned = true;
+    }
+}
+
+void TextureResidencyManager::unregisterTexture(GLuint textureId)
+{
+    auto residentTexture = residentTextures.find(textureId);
+    if (residentTexture == residentTextures.end()) {
+        return;
+    }
+
+    // Only the levels from the base level down are allocated
+    const std::vector<size_t>& levelBytes = residentTexture->second.levelBytes;
+    for (size_t level = static_cast<size_t>(residentTexture->second.baseLevel); level < levelBytes.size(); ++level) {
+        residentBytes -= levelBytes[level];
+    }
+    residentTextures.erase(residentTexture);
+}
+
+void TextureResidencyManager::unregisterTextures()
+{
+    residentTextures.clear();
+    residentBytes = 0;
+}
+
+void TextureResidencyManager::requestTexture(GLuint textureId, float projectedSize)
+{
+    auto found = residentTextures.find(textureId);
+    if (found == residentTextures.end()) {
+        return;
+    }
+
+    ResidentTexture& residentTexture = found->second;
+    residentTexture.lastUsedFrame = frame;
+
+    // One texel per pixel, each coarser level halves the texels
+    int requiredLevel = residentTexture.coarsestBaseLevel;
+    if (projectedSize > 0.0f) {
+        float texelsPerPixel = static_cast<float>(std::max(residentTexture.width, residentTexture.height)) / projectedSize;
+        requiredLevel = static_cast<int>(std::floor(std::log2(std::max(texelsPerPixel, 1.0f))));
+    }
+
+    // Several meshes can share the texture, keep the finest request
+    residentTexture.requiredLevel = std::min(residentTexture.requiredLevel, std::min(requiredLevel, residentTexture.coarsestBaseLevel));
+}
+
+void TextureResidencyManager::updateResidency()
+{
+    // Stream the textures missing the most levels first
+    std::vector<std::pair<int, GLuint>> missingLevels;
+    for (const auto& tracked : residentTextures) {
+        const ResidentTexture& residentTexture = tracked.second;
+        if (!residentTexture.pinned && residentTexture.lastUsedFrame == frame && residentTexture.requiredLevel < residentTexture.baseLevel) {
+            missingLevels.push_back({ residentTexture.baseLevel - residentTexture.requiredLevel, tracked.first });
+        }
+    }
+    std::sort(missingLevels.begin(), missingLevels.end(), [](const std::pair<int, GLuint>& a, const std::pair<int, GLuint>& b) { return a.first > b.first; });
+
+    size_t streamedThisUpdate = 0;
+    for (const auto& missing : missingLevels) {
+        ResidentTexture& residentTexture = residentTextures[missing.second];
+
+        while (residentTexture.baseLevel > residentTexture.requiredLevel && streamedThisUpdate < MAX_STREAMED_BYTES_PER_UPDATE) {
+            size_t bytes = residentTexture.levelBytes[residentTexture.baseLevel - 1];
+            if (!makeRoom(bytes, missing.second) || !streamLevel(missing.second, residentTexture)) {
+                break;
+            }
+            streamedThisUpdate += bytes;
+        }
+    }
+
+    // The budget may have been lowered or textures created over it
+    makeRoom(0, 0);
+
+    // Requests are made again every frame
+    for (auto& tracked : residentTextures) {
+        tracked.second.requiredLevel = tracked.second.coarsestBaseLevel;
+    }
+    ++frame;
+}
+
+
+// ###################
+// #                 #
+// # Private methods #
+// #                 #
+// ###################
+
+
+// ################
+// # Constructors #
+// ################
+
+
+TextureResidencyManager::TextureResidencyManager()
+    : budgetBytes(DEFAULT_BUDGET_BYTES), residentBytes(0), streamedBytes(0), evictedBytes(0), frame(1)
+{
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+bool TextureResidencyManager::makeRoom(size_t bytesNeeded, GLuint streamingTextureId)
+{
+    while (residentBytes + bytesNeeded > budgetBytes) {
+        // Least recently used texture that still has a level it can give up
+        ResidentTexture* evictTexture = nullptr;
+        GLuint evictTextureId = 0;
+
+        for (auto& tracked : residentTextures) {
+            ResidentTexture& residentTexture = tracked.second;
+            bool drawnThisFrame = residentTexture.lastUsedFrame == frame;
+
+            if (residentTexture.pinned || tracked.first == streamingTextureId || residentTexture.baseLevel >= residentTexture.coarsestBaseLevel) {
+                continue;
+            }
+            if (drawnThisFrame && residentTexture.baseLevel >= residentTexture.requiredLevel) {
+                continue;
+            }
+
+            if (evictTexture == nullptr || residentTexture.lastUsedFrame < evictTexture->lastUsedFrame) {
+                evictTexture = &residentTexture;
+                evictTextureId = tracked.first;
+            }
+        }
+
+        if (evictTexture == nullptr) {
+            return false;
+        }
+
+        evictLevel(evictTextureId, *evictTexture);
+    }
+
+    return true;
+}
+
+bool TextureResidencyManager::streamLevel(GLuint textureId, ResidentTexture& residentTexture)
+{
+    TextureManager& textureManager = TextureManager::getInstance();
+    int level = residentTexture.baseLevel - 1;
+    int levelWidth = std::max(1, residentTexture.width >> level);
+    int levelHeight = std::max(1, residentTexture.height >> level);
+    GLenum internalFormat = (residentTexture.channels == 4) ? GL_RGBA8 : GL_RGB8;
+    GLenum format = (residentTexture.channels == 4) ? GL_RGBA : GL_RGB;
+
+    // Load every layer before touching the texture so a failed read leaves it unchanged
+    std::vector<MipLevel> layers(residentTexture.filenames.size());
+    for (size_t layer = 0; layer < layers.size(); ++layer) {
+        if (!textureManager.loadMipLevel(residentTexture.filenames[layer].c_str(), level, layers[layer])) {
+            cout << "Failed to stream mip level " << level << " of " << residentTexture.filenames[layer] << endl;
+            return false;
+        }
+    }
+
+    // Keep the renderer's binding intact
+    GLint previousTextureId;
+    glGetIntegerv(getBindingQuery(residentTexture.target), &previousTextureId);
+    glBindTexture(residentTexture.target, textureId);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (residentTexture.target == GL_TEXTURE_2D_ARRAY) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, levelWidth, levelHeight, static_cast<GLsizei>(layers.size()), 0, format, GL_UNSIGNED_BYTE, NULL);
+        for (size_t layer = 0; layer < layers.size(); ++layer) {
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, static_cast<GLint>(layer), levelWidth, levelHeight, 1, format, GL_UNSIGNED_BYTE, layers[layer].data());
+        }
+    }
+    else {
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat, levelWidth, levelHeight, 0, format, GL_UNSIGNED_BYTE, layers[0].data());
+    }
+    glTexParameteri(residentTexture.target, GL_TEXTURE_BASE_LEVEL, level);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(residentTexture.target, previousTextureId);
+
+    residentTexture.baseLevel = level;
+    residentBytes += residentTexture.levelBytes[level];
+    streamedBytes += residentTexture.levelBytes[level];
+
+    return true;
+}
+
+void TextureResidencyManager::evictLevel(GLuint textureId, ResidentTexture& residentTexture)
+{
+    int level = residentTexture.baseLevel;
+    GLenum internalFormat = (residentTexture.channels == 4) ? GL_RGBA8 : GL_RGB8;
+    GLenum format = (residentTexture.channels == 4) ? GL_RGBA : GL_RGB;
+
+    // Keep the renderer's binding intact
+    GLint previousTextureId;
+    glGetIntegerv(getBindingQuery(residentTexture.target), &previousTextureId);
+    glBindTexture(residentTexture.target, textureId);
+
+    // Sample from the next level, then respecify the dropped level as empty to release its storage
+    glTexParameteri(residentTexture.target, GL_TEXTURE_BASE_LEVEL, level + 1);
+    if (residentTexture.target == GL_TEXTURE_2D_ARRAY) {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, level, internalFormat, 0, 0, 0, 0, format, GL_UNSIGNED_BYTE, NULL);
+    }
+    else {
+        glTexImage2D(GL_TEXTURE_2D, level, internalFormat, 0, 0, 0, format, GL_UNSIGNED_BYTE, NULL);
+    }
+
+    glBindTexture(residentTexture.target, previousTextureId);
+
+    residentTexture.baseLevel = level + 1;
+    residentBytes -= residentTexture.levelBytes[level];
+    evictedBytes += residentTexture.levelBytes[level];
+}
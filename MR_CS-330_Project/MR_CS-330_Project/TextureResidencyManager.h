@@ -0,0 +1,215 @@
+// TextureResidencyManager.h
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Class representing the manager keeping texture mip levels resident on the GPU within a memory budget.
+ * Each frame the renderer requests the textures it draws with their projected screen size, finer levels
+ * are streamed in from the mip cache when needed and the finest levels of the least recently used
+ * textures are dropped (raising GL_TEXTURE_BASE_LEVEL) to stay under the budget.
+ */
+class TextureResidencyManager {
+public:
+    // ######################
+    // # Singleton Instance #
+    // ######################
+
+
+    /**
+     * Get the Texture Residency Manager Singleton Instance
+     */
+    static TextureResidencyManager& getInstance();
+
+    // Prevent copying and assignment
+    TextureResidencyManager(const TextureResidencyManager&) = delete;
+    void operator=(const TextureResidencyManager&) = delete;
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the budget for resident texture memory.
+     *
+     * @return The budget in bytes.
+     */
+    const size_t getBudget() const;
+
+    /**
+     * Get the estimated texture memory of every resident level.
+     *
+     * @return The resident bytes.
+     */
+    const size_t getResidentBytes() const;
+
+    /**
+     * Get the total texture memory streamed in since startup.
+     *
+     * @return The streamed bytes.
+     */
+    const size_t getStreamedBytes() const;
+
+    /**
+     * Get the total texture memory evicted since startup.
+     *
+     * @return The evicted bytes.
+     */
+    const size_t getEvictedBytes() const;
+
+
+    // ##################
+    // # Setter methods #
+    // ##################
+
+
+    /**
+     * Set the budget for resident texture memory, applied on the next update.
+     *
+     * @param budgetBytes The budget in bytes.
+     */
+    void setBudget(size_t budgetBytes);
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Start tracking a texture with every level resident.
+     *
+     * @param textureId The texture id.
+     * @param target GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY.
+     * @param filenames Image file of each layer (a single image for GL_TEXTURE_2D).
+     * @param width Width of level 0 in texels.
+     * @param height Height of level 0 in texels.
+     * @param channels Number of channels per texel (3 = RGB, 4 = RGBA).
+     * @param levelCount Number of mip levels.
+     */
+    void registerTexture(GLuint textureId, GLenum target, const std::vector<std::string>& filenames, int width, int height, int channels, int levelCount);
+
+    /**
+     * Keep every resident level of a texture, for textures whose storage can no longer change (bindless).
+     *
+     * @param textureId The texture id.
+     */
+    void pinTexture(GLuint textureId);
+
+    /**
+     * Stop tracking a texture deleted before the others.
+     *
+     * @param textureId The texture id.
+     */
+    void unregisterTexture(GLuint textureId);
+
+    /**
+     * Stop tracking every texture.
+     */
+    void unregisterTextures();
+
+    /**
+     * Mark a texture as drawn this frame and request the mip level its projected size needs.
+     *
+     * @param textureId The texture id.
+     * @param projectedSize Size in pixels the texture covers on screen.
+     */
+    void requestTexture(GLuint textureId, float projectedSize);
+
+    /**
+     * Stream in the levels requested this frame and evict levels to stay under the budget.
+     * Called once per frame after drawing.
+     */
+    void updateResidency();
+
+
+    // #############
+    // # Variables #
+    // #############
+
+
+    // Class constants
+    static constexpr size_t DEFAULT_BUDGET_BYTES = 256 * 1024 * 1024;
+    static constexpr size_t MAX_STREAMED_BYTES_PER_UPDATE = 16 * 1024 * 1024;  // Limits upload stalls per frame
+    static constexpr int MIN_RESIDENT_SIZE = 64;                                // Levels this size and smaller are never evicted
+
+private:
+    /**
+     * Struct representing the residency state of a tracked texture.
+     */
+    struct ResidentTexture {
+        GLenum target;                      // GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY
+        std::vector<std::string> filenames; // Image file of each layer
+        int width;                          // Width of level 0 in texels
+        int height;                         // Height of level 0 in texels
+        int channels;                       // Number of channels per texel
+        std::vector<size_t> levelBytes;     // Estimated GPU bytes of each level (all layers)
+        int baseLevel;                      // Finest resident level
+        int coarsestBaseLevel;              // Finest level that is never evicted
+        int requiredLevel;                  // Finest level requested this frame
+        unsigned long long lastUsedFrame;   // Frame the texture was last requested in
+        bool pinned;                        // Levels can not be streamed or evicted
+    };
+
+
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * TextureResidencyManager constructor.
+     */
+    TextureResidencyManager();
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Evict levels of the least recently used textures until the bytes fit in the budget.
+     * Textures drawn this frame only lose levels finer than they requested.
+     *
+     * @param bytesNeeded Bytes about to be streamed in.
+     * @param streamingTextureId Texture being streamed in, never evicted from.
+     * @return True if the bytes fit in the budget.
+     */
+    bool makeRoom(size_t bytesNeeded, GLuint streamingTextureId);
+
+    /**
+     * Upload the level one finer than the base level and lower the base level to it.
+     *
+     * @param textureId The texture id.
+     * @param residentTexture The residency state of the texture.
+     * @return True if the level was uploaded.
+     */
+    bool streamLevel(GLuint textureId, ResidentTexture& residentTexture);
+
+    /**
+     * Raise the base level one level and release the storage of the previous base level.
+     *
+     * @param textureId The texture id.
+     * @param residentTexture The residency state of the texture.
+     */
+    void evictLevel(GLuint textureId, ResidentTexture& residentTexture);
+
+
+    // #############
+    // # Variables #
+    // #############
+
+    std::map<GLuint, ResidentTexture> residentTextures; // Tracked textures by texture id
+    size_t budgetBytes;                                 // Budget for resident texture memory
+    size_t residentBytes;                               // Estimated memory of every resident level
+    size_t streamedBytes;                               // Total memory streamed in
+    size_t evictedBytes;                                // Total memory evicted
+    unsigned long long frame;                           // Current frame, for LRU ordering
+};
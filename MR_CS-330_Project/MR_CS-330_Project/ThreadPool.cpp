@@ -0,0 +1,162 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// ######################
+// # Singleton Instance #
+// ######################
+
+
+ThreadPool& ThreadPool::getInstance()
+{
+    static ThreadPool instance;
+    return instance;
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCondition.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+
+// ##################
+// # Getter methods #
+// ##################
+
+
+const unsigned int ThreadPool::getThreadCount() const
+{
+    // Workers plus the thread calling parallelFor
+    return static_cast<unsigned int>(workers.size()) + 1;
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& task, unsigned int maxThreads)
+{
+    if (count == 0) {
+        return;
+    }
+
+    size_t chunkCount = (maxThreads == 0) ? getThreadCount() : maxThreads;
+    chunkCount = std::min(chunkCount, count);
+
+    // Nothing to split, run inline
+    if (chunkCount <= 1) {
+        task(0, count);
+        return;
+    }
+
+    std::atomic<size_t> chunksRemaining(chunkCount);
+
+    // Queue every chunk except the first, which the calling thread runs itself
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+            size_t begin = count * chunk / chunkCount;
+            size_t end = count * (chunk + 1) / chunkCount;
+
+            pendingTasks.push([&task, &chunksRemaining, begin, end]() {
+                task(begin, end);
+                chunksRemaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+    }
+    queueCondition.notify_all();
+
+    task(0, count / chunkCount);
+    chunksRemaining.fetch_sub(1, std::memory_order_release);
+
+    // Help with queued work (including nested parallelFor chunks) until every chunk is done
+    while (chunksRemaining.load(std::memory_order_acquire) > 0) {
+        if (!runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+
+// ###################
+// #                 #
+// # Private methods #
+// #                 #
+// ###################
+
+
+// ################
+// # Constructors #
+// ################
+
+
+ThreadPool::ThreadPool() : stopping(false)
+{
+    unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned int i = 1; i < hardwareThreads; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+void ThreadPool::workerLoop()
+{
+    while (true) {
+        std::function<void()> pendingTask;
+
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this]() { return stopping || !pendingTasks.empty(); });
+
+            if (stopping && pendingTasks.empty()) {
+                return;
+            }
+
+            pendingTask = std::move(pendingTasks.front());
+            pendingTasks.pop();
+        }
+
+        pendingTask();
+    }
+}
+
+bool ThreadPool::runPendingTask()
+{
+    std::function<void()> pendingTask;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (pendingTasks.empty()) {
+            return false;
+        }
+
+        pendingTask = std::move(pendingTasks.front());
+        pendingTasks.pop();
+    }
+
+    pendingTask();
+    return true;
+}
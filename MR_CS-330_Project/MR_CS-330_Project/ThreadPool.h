@@ -0,0 +1,107 @@
+// ThreadPool.h
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * Class representing a pool of persistent worker threads for splitting CPU work into ranges.
+ */
+class ThreadPool {
+public:
+    // ######################
+    // # Singleton Instance #
+    // ######################
+
+
+    /**
+     * Get the Thread Pool Singleton Instance
+     */
+    static ThreadPool& getInstance();
+
+    // Prevent copying and assignment
+    ThreadPool(const ThreadPool&) = delete;
+    void operator=(const ThreadPool&) = delete;
+
+    /**
+     * ThreadPool destructor.
+     * Stops and joins all worker threads.
+     */
+    ~ThreadPool();
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the number of threads that can work on a task at once (workers plus the calling thread).
+     *
+     * @return The number of threads.
+     */
+    const unsigned int getThreadCount() const;
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Split the range [0, count) into contiguous chunks and run the task on each chunk in parallel.
+     * The calling thread works on the first chunk and helps with queued work until every chunk is done.
+     *
+     * @param count The number of items in the range.
+     * @param task The task to run for each chunk, given the chunk begin (inclusive) and end (exclusive).
+     * @param maxThreads The maximum number of chunks to split the range into (0 = use every thread).
+     */
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)>& task, unsigned int maxThreads = 0);
+
+private:
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * ThreadPool constructor.
+     * Starts one worker per hardware thread, less the calling thread.
+     */
+    ThreadPool();
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Worker thread loop, waits for queued work until the pool is stopped.
+     */
+    void workerLoop();
+
+    /**
+     * Run a single queued task on the calling thread if one is available.
+     *
+     * @return True if a task was run.
+     */
+    bool runPendingTask();
+
+
+    // #############
+    // # Variables #
+    // #############
+
+    std::vector<std::thread> workers;               // Persistent worker threads
+    std::queue<std::function<void()>> pendingTasks; // Queued chunks waiting for a thread
+    std::mutex queueMutex;                          // Guards the pending task queue and stop flag
+    std::condition_variable queueCondition;         // Wakes workers when work is queued or the pool stops
+    bool stopping;                                  // Set when the pool is shutting down
+};
@@ -56,7 +56,42 @@ public:
      */
     void generateVertices() override;
 
+protected:
+    // ############################
+    // # Virtual method overrides #
+    // ############################
+
+
+    /**
+     * Set the detail the vertices are generated with, each level halving the slices and stacks of the Torus.
+     *
+     * @param level The level of detail (0 = the detail the Torus was created with).
+     * @return The largest angle between neighboring slices or stacks at the level in radians.
+     */
+    float setDetailLevel(int level) override;
+
+    /**
+     * Get the parameters the procedural vertex shader builds the Torus from, at the current detail level.
+     *
+     * @param geometry Reference to store the parameters in.
+     * @return True, a Torus can always be pulled.
+     */
+    bool getProceduralGeometry(ProceduralGeometry& geometry) const override;
+
 private:
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Generate the vertex and element buffer in a vertex format.
+     *
+     * @tparam VertexType The vertex format matching the vertex mode.
+     */
+    template <typename VertexType>
+    void generateFormattedVertices();
+
 
     // #############
     // # Variables #
@@ -65,5 +100,7 @@ private:
     float outerRadius;  // The distance from the center to the outside of the tube
     float innerRadius;  // The distance from the center to the inside of the tube
     int slices;         // The number of lines of longitude, these are slices parallel to the z-axis and go around the tube the short way (through the hole)
+    int fullSlices;     // The number of slices the Torus was created with (full detail)
     int stacks;         // The number of lines of latitude plus 1, these lines are perpendicular to the z-axis and go around the tube the long way (arouind the hole)
+    int fullStacks;     // The number of stacks the Torus was created with (full detail)
 };
\ No newline at end of file
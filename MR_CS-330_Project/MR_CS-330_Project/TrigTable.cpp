@@ -0,0 +1,53 @@
+#include "TrigTable.h"
+#include <cmath>
+#include <map>
+#include <tuple>
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// ################
+// # Constructors #
+// ################
+
+
+TrigTable::TrigTable(int steps, GLfloat startAngle, GLfloat angleRange)
+    : steps(steps), sines(steps + 1), cosines(steps + 1)
+{
+    // Angles are stepped the same as the generators did, so the values match calling sin and cos per vertex
+    GLfloat angleIncrement = angleRange / steps;
+    for (int step = 0; step <= steps; ++step) {
+        GLfloat angle = startAngle + step * angleIncrement;
+        sines[step] = std::sin(angle);
+        cosines[step] = std::cos(angle);
+    }
+}
+
+
+// ##################
+// # Getter methods #
+// ##################
+
+
+const TrigTable& TrigTable::get(int steps, GLfloat startAngle, GLfloat angleRange)
+{
+    // Each thread keeps its own tables so generators running in parallel never wait on a lock
+    thread_local std::map<std::tuple<int, GLfloat, GLfloat>, TrigTable> tables;
+
+    auto key = std::make_tuple(steps, startAngle, angleRange);
+    auto it = tables.find(key);
+    if (it == tables.end()) {
+        it = tables.emplace(key, TrigTable(steps, startAngle, angleRange)).first;
+    }
+    return it->second;
+}
+
+const int TrigTable::getSteps() const
+{
+    return steps;
+}
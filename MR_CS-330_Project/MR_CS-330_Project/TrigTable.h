@@ -0,0 +1,82 @@
+// TrigTable.h
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+
+/**
+ * Class representing the sines and cosines of evenly spaced angles, for the slices, stacks, and sectors of the
+ * parametric meshes. Generators look the values up instead of calling sin and cos for every vertex, so generating
+ * a vertex is only multiplies and adds. Tables are computed once and shared by every mesh with the same spacing.
+ */
+class TrigTable {
+public:
+    // ################
+    // # Constructors #
+    // ################
+
+
+    /**
+     * TrigTable constructor.
+     *
+     * @param steps The number of steps the angle range is divided into, the table has steps + 1 angles.
+     * @param startAngle The first angle in radians.
+     * @param angleRange The angle from the first to the last angle in radians.
+     */
+    TrigTable(int steps, GLfloat startAngle, GLfloat angleRange);
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the shared table for a spacing of angles, computing it the first time it is used on the calling thread.
+     *
+     * @param steps The number of steps the angle range is divided into, the table has steps + 1 angles.
+     * @param startAngle The first angle in radians.
+     * @param angleRange The angle from the first to the last angle in radians.
+     * @return The table, valid for the life of the thread.
+     */
+    static const TrigTable& get(int steps, GLfloat startAngle, GLfloat angleRange);
+
+    /**
+     * Get the number of steps the angle range is divided into.
+     *
+     * @return The number of steps.
+     */
+    const int getSteps() const;
+
+    /**
+     * Get the sine of an angle, inline so the generators' vertex loops compile to plain loads.
+     *
+     * @param step The index of the angle (0 to steps).
+     * @return The sine of startAngle + step * angleRange / steps.
+     */
+    const GLfloat getSin(int step) const
+    {
+        return sines[step];
+    }
+
+    /**
+     * Get the cosine of an angle.
+     *
+     * @param step The index of the angle (0 to steps).
+     * @return The cosine of startAngle + step * angleRange / steps.
+     */
+    const GLfloat getCos(int step) const
+    {
+        return cosines[step];
+    }
+
+private:
+    // #############
+    // # Variables #
+    // #############
+
+
+    int steps;                      // The number of steps the angle range is divided into
+    std::vector<GLfloat> sines;     // The sine of each angle, in order
+    std::vector<GLfloat> cosines;   // The cosine of each angle, in order
+};
@@ -0,0 +1,302 @@
+// VertexFormat.h
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <cstring>
+#include <type_traits>
+
+// Enum for VertexMode
+enum VertexMode {
+    POSITION_COLOR,         // (x, y, z, r, g, b, a)
+    POSITION_UV,            // (x, y, z, u, v)
+    POSITION_COLOR_UV,      // (x, y, z, r, g, b, a, u, v)
+    POSITION_NORMAL_UV      // (x, y, z, nx, ny, nz, u, v)
+};
+
+
+/**
+ * Struct representing how positions were quantized, quantized positions are (position - center) / scale.
+ * A single scale for every axis keeps the dequantization a uniform scale, so normals are unaffected by it.
+ */
+struct VertexQuantization {
+    glm::vec3 center;                           // Center of the position bounds
+    float scale;                                // Largest half extent of the position bounds
+};
+
+
+// #####################
+// # Vertex attributes #
+// #####################
+
+
+/**
+ * Struct describing the position vertex attribute.
+ */
+struct Position {
+    using Type = glm::vec3;
+    static constexpr GLuint LOCATION = 0;       // Shader attribute location
+    static constexpr GLuint COMPONENTS = 3;     // Number of floats in the attribute
+
+    // Quantized as normalized int16 relative to the bounds, padded to 4 components for alignment
+    static constexpr GLenum QUANTIZED_TYPE = GL_SHORT;
+    static constexpr GLint QUANTIZED_COMPONENTS = 4;
+    static constexpr GLsizei QUANTIZED_SIZE = 4 * sizeof(GLshort);
+
+    static void quantize(const GLfloat* values, const VertexQuantization& quantization, unsigned char* destination)
+    {
+        GLshort quantized[4] = { 0, 0, 0, 0 };
+        for (int i = 0; i < 3; ++i) {
+            float normalized = glm::clamp((values[i] - quantization.center[i]) / quantization.scale, -1.0f, 1.0f);
+            quantized[i] = static_cast<GLshort>(glm::round(normalized * 32767.0f));
+        }
+        std::memcpy(destination, quantized, sizeof(quantized));
+    }
+};
+
+/**
+ * Struct describing the color vertex attribute.
+ */
+struct Color {
+    using Type = glm::vec4;
+    static constexpr GLuint LOCATION = 1;       // Shader attribute location
+    static constexpr GLuint COMPONENTS = 4;     // Number of floats in the attribute
+
+    // Quantized as normalized uint8
+    static constexpr GLenum QUANTIZED_TYPE = GL_UNSIGNED_BYTE;
+    static constexpr GLint QUANTIZED_COMPONENTS = 4;
+    static constexpr GLsizei QUANTIZED_SIZE = 4 * sizeof(GLubyte);
+
+    static void quantize(const GLfloat* values, const VertexQuantization& /*quantization*/, unsigned char* destination)
+    {
+        for (int i = 0; i < 4; ++i) {
+            destination[i] = static_cast<GLubyte>(glm::round(glm::clamp(values[i], 0.0f, 1.0f) * 255.0f));
+        }
+    }
+};
+
+/**
+ * Struct describing the normal vertex attribute.
+ */
+struct Normal {
+    using Type = glm::vec3;
+    static constexpr GLuint LOCATION = 2;       // Shader attribute location
+    static constexpr GLuint COMPONENTS = 3;     // Number of floats in the attribute
+
+    // Quantized as normalized signed 10 bits per component
+    static constexpr GLenum QUANTIZED_TYPE = GL_INT_2_10_10_10_REV;
+    static constexpr GLint QUANTIZED_COMPONENTS = 4;
+    static constexpr GLsizei QUANTIZED_SIZE = sizeof(GLuint);
+
+    static void quantize(const GLfloat* values, const VertexQuantization& /*quantization*/, unsigned char* destination)
+    {
+        // Scales baked into the vertices leave normals off unit length, clamping those would also turn them
+        glm::vec3 normal(values[0], values[1], values[2]);
+        float length = glm::length(normal);
+        if (length > 0.0f) {
+            normal /= length;
+        }
+
+        GLuint packed = 0;
+        for (int i = 0; i < 3; ++i) {
+            GLint component = static_cast<GLint>(glm::round(glm::clamp(normal[i], -1.0f, 1.0f) * 511.0f));
+            packed |= (static_cast<GLuint>(component) & 0x3FF) << (10 * i);
+        }
+        std::memcpy(destination, &packed, sizeof(packed));
+    }
+};
+
+/**
+ * Struct describing the texture coordinate vertex attribute.
+ */
+struct UV {
+    using Type = glm::vec2;
+    static constexpr GLuint LOCATION = 3;       // Shader attribute location
+    static constexpr GLuint COMPONENTS = 2;     // Number of floats in the attribute
+
+    // Quantized as normalized uint16, only for coordinates within [0, 1]
+    static constexpr GLenum QUANTIZED_TYPE = GL_UNSIGNED_SHORT;
+    static constexpr GLint QUANTIZED_COMPONENTS = 2;
+    static constexpr GLsizei QUANTIZED_SIZE = 2 * sizeof(GLushort);
+
+    static void quantize(const GLfloat* values, const VertexQuantization& /*quantization*/, unsigned char* destination)
+    {
+        GLushort quantized[2];
+        for (int i = 0; i < 2; ++i) {
+            quantized[i] = static_cast<GLushort>(glm::round(glm::clamp(values[i], 0.0f, 1.0f) * 65535.0f));
+        }
+        std::memcpy(destination, quantized, sizeof(quantized));
+    }
+};
+
+
+// #################
+// # Vertex format #
+// #################
+
+
+/**
+ * Struct representing a single interleaved vertex made of the listed attributes, in order.
+ * The layout (stride and attribute offsets) is known at compile time, so generators can write
+ * whole vertices without branching on the format and the VAO setup is derived from the type.
+ */
+template <typename... Attributes>
+struct Vertex {
+    // Class constants
+    static constexpr GLuint FLOATS_PER_VERTEX = (Attributes::COMPONENTS + ...);
+    static constexpr GLsizei STRIDE = sizeof(GLfloat) * FLOATS_PER_VERTEX;
+    static constexpr GLsizei QUANTIZED_STRIDE = (Attributes::QUANTIZED_SIZE + ...);
+
+    /**
+     * Check if the format has an attribute.
+     *
+     * @return True if the attribute is one of the format's attributes.
+     */
+    template <typename Attribute>
+    static constexpr bool hasAttribute()
+    {
+        return (std::is_same_v<Attribute, Attributes> || ...);
+    }
+
+    /**
+     * Get the number of floats of an attribute in the format.
+     *
+     * @return The number of floats, 0 if the format does not have the attribute.
+     */
+    template <typename Attribute>
+    static constexpr GLuint getComponents()
+    {
+        return hasAttribute<Attribute>() ? Attribute::COMPONENTS : 0;
+    }
+
+    /**
+     * Get the number of floats before an attribute in the format.
+     *
+     * @return The offset in floats.
+     */
+    template <typename Attribute>
+    static constexpr GLuint getOffset()
+    {
+        GLuint offset = 0;
+        bool found = false;
+        ((found = found || std::is_same_v<Attribute, Attributes>, offset += found ? 0 : Attributes::COMPONENTS), ...);
+        return offset;
+    }
+
+    /**
+     * Get the number of bytes before an attribute in the quantized format.
+     *
+     * @return The offset in bytes.
+     */
+    template <typename Attribute>
+    static constexpr GLsizei getQuantizedOffset()
+    {
+        GLsizei offset = 0;
+        bool found = false;
+        ((found = found || std::is_same_v<Attribute, Attributes>, offset += found ? 0 : Attributes::QUANTIZED_SIZE), ...);
+        return offset;
+    }
+
+    /**
+     * Set the attribute pointers of every attribute in the format on the bound VAO and VBO.
+     */
+    static void setAttributePointers()
+    {
+        (setAttributePointer<Attributes>(), ...);
+    }
+
+    /**
+     * Set the normalized attribute pointers of every attribute in the quantized format on the bound VAO and VBO.
+     */
+    static void setQuantizedAttributePointers()
+    {
+        (setQuantizedAttributePointer<Attributes>(), ...);
+    }
+
+    /**
+     * Quantize the attributes of a vertex into the quantized format.
+     *
+     * @param values The float values of the vertex.
+     * @param quantization The position quantization.
+     * @param destination The QUANTIZED_STRIDE bytes to write the vertex to.
+     */
+    static void quantize(const GLfloat* values, const VertexQuantization& quantization, unsigned char* destination)
+    {
+        (Attributes::quantize(values + getOffset<Attributes>(), quantization, destination + getQuantizedOffset<Attributes>()), ...);
+    }
+
+    /**
+     * Set the value of an attribute, does nothing if the format does not have the attribute.
+     *
+     * @param value The attribute value.
+     */
+    template <typename Attribute>
+    void set(const typename Attribute::Type& value)
+    {
+        if constexpr (hasAttribute<Attribute>()) {
+            for (GLuint i = 0; i < Attribute::COMPONENTS; ++i) {
+                values[getOffset<Attribute>() + i] = value[i];
+            }
+        }
+    }
+
+    GLfloat values[FLOATS_PER_VERTEX];          // Interleaved attribute values
+
+private:
+    /**
+     * Set the attribute pointer of a single attribute on the bound VAO and VBO.
+     */
+    template <typename Attribute>
+    static void setAttributePointer()
+    {
+        glVertexAttribPointer(Attribute::LOCATION, Attribute::COMPONENTS, GL_FLOAT, GL_FALSE, STRIDE, (char*)(sizeof(GLfloat) * getOffset<Attribute>()));
+        glEnableVertexAttribArray(Attribute::LOCATION);
+    }
+
+    /**
+     * Set the normalized attribute pointer of a single quantized attribute on the bound VAO and VBO.
+     */
+    template <typename Attribute>
+    static void setQuantizedAttributePointer()
+    {
+        glVertexAttribPointer(Attribute::LOCATION, Attribute::QUANTIZED_COMPONENTS, Attribute::QUANTIZED_TYPE, GL_TRUE, QUANTIZED_STRIDE,
+            (char*)(static_cast<size_t>(getQuantizedOffset<Attribute>())));
+        glEnableVertexAttribArray(Attribute::LOCATION);
+    }
+};
+
+// Vertex formats of each VertexMode
+using PositionColorVertex = Vertex<Position, Color>;
+using PositionUVVertex = Vertex<Position, UV>;
+using PositionColorUVVertex = Vertex<Position, Color, UV>;
+using PositionNormalUVVertex = Vertex<Position, Normal, UV>;
+
+static_assert(sizeof(PositionNormalUVVertex) == PositionNormalUVVertex::STRIDE, "Vertices must be tightly packed to alias the vertex buffer");
+static_assert(PositionNormalUVVertex::QUANTIZED_STRIDE == 16, "Quantized POSITION_NORMAL_UV vertices are 16 bytes");
+
+
+/**
+ * Call a function with a default constructed vertex of the format matching a VertexMode.
+ * Dispatches on the runtime mode once so the function body is compiled per format.
+ *
+ * @param vertexMode The VertexMode.
+ * @param function Generic callable taking the vertex, its type selects the format.
+ */
+template <typename Function>
+void visitVertexFormat(VertexMode vertexMode, Function&& function)
+{
+    switch (vertexMode) {
+    case POSITION_COLOR:
+        function(PositionColorVertex{});
+        break;
+    case POSITION_UV:
+        function(PositionUVVertex{});
+        break;
+    case POSITION_COLOR_UV:
+        function(PositionColorUVVertex{});
+        break;
+    case POSITION_NORMAL_UV:
+        function(PositionNormalUVVertex{});
+        break;
+    }
+}
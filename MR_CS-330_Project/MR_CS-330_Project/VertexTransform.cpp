@@ -0,0 +1,300 @@
+#include "VertexTransform.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>      // SSE intrinsics for 4 vertices per iteration
+#include <immintrin.h>      // AVX intrinsics for 8 vertices per iteration
+#define VERTEX_TRANSFORM_SSE
+#ifdef _MSC_VER
+#include <intrin.h>         // __cpuid, _xgetbv
+#define VERTEX_TRANSFORM_AVX_TARGET
+#else
+#include <cpuid.h>          // __get_cpuid
+#define VERTEX_TRANSFORM_AVX_TARGET __attribute__((target("avx")))
+#endif
+#endif
+
+// Unnamed namespace
+namespace
+{
+    /**
+     * Struct representing the x, y, and z of the columns of a transform, the last column is the translation.
+     */
+    struct TransformColumns {
+        GLfloat values[4][3];
+    };
+
+    TransformColumns getColumns(const glm::mat4& transform)
+    {
+        TransformColumns columns;
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 3; ++row) {
+                columns.values[column][row] = transform[column][row];
+            }
+        }
+        return columns;
+    }
+
+    TransformColumns getColumns(const glm::mat3& transform)
+    {
+        TransformColumns columns = {};
+        for (int column = 0; column < 3; ++column) {
+            for (int row = 0; row < 3; ++row) {
+                columns.values[column][row] = transform[column][row];
+            }
+        }
+        return columns;
+    }
+
+    /**
+     * Transform the 3 floats at the start of each of count vertices, stride floats apart.
+     * Positions (TRANSLATE) add (c0 * x + c1 * y) + (c2 * z + c3), normals (c0 * x + c1 * y) + c2 * z, the same as glm.
+     */
+    template<bool TRANSLATE>
+    void transformScalar(const GLfloat* source, GLfloat* destination, size_t count, size_t stride, const TransformColumns& columns)
+    {
+        const GLfloat (*c)[3] = columns.values;
+        for (size_t vertex = 0; vertex < count; ++vertex) {
+            GLfloat x = source[0];
+            GLfloat y = source[1];
+            GLfloat z = source[2];
+            for (int row = 0; row < 3; ++row) {
+                destination[row] = TRANSLATE
+                    ? (c[0][row] * x + c[1][row] * y) + (c[2][row] * z + c[3][row])
+                    : (c[0][row] * x + c[1][row] * y) + c[2][row] * z;
+            }
+            source += stride;
+            destination += stride;
+        }
+    }
+
+#ifdef VERTEX_TRANSFORM_SSE
+    /**
+     * Transform 4 vertices per iteration, loading 4 floats from each vertex and transposing them to x, y, and z registers.
+     * Needs at least 4 floats from the start of the attribute to the end of the vertex.
+     */
+    template<bool TRANSLATE>
+    void transformSSE(const GLfloat* source, GLfloat* destination, size_t count, size_t stride, const TransformColumns& columns)
+    {
+        __m128 c[4][3];
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 3; ++row) {
+                c[column][row] = _mm_set1_ps(columns.values[column][row]);
+            }
+        }
+
+        size_t vertex = 0;
+        for (; vertex + 4 <= count; vertex += 4) {
+            const GLfloat* vertexSource = source + vertex * stride;
+            GLfloat* vertexDestination = destination + vertex * stride;
+
+            __m128 x = _mm_loadu_ps(vertexSource);
+            __m128 y = _mm_loadu_ps(vertexSource + stride);
+            __m128 z = _mm_loadu_ps(vertexSource + stride * 2);
+            __m128 w = _mm_loadu_ps(vertexSource + stride * 3);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+
+            __m128 result[4];
+            for (int row = 0; row < 3; ++row) {
+                __m128 xy = _mm_add_ps(_mm_mul_ps(c[0][row], x), _mm_mul_ps(c[1][row], y));
+                __m128 zw = TRANSLATE ? _mm_add_ps(_mm_mul_ps(c[2][row], z), c[3][row]) : _mm_mul_ps(c[2][row], z);
+                result[row] = _mm_add_ps(xy, zw);
+            }
+            result[3] = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(result[0], result[1], result[2], result[3]);
+
+            // Only the 3 transformed floats of each vertex are written
+            for (int i = 0; i < 4; ++i) {
+                _mm_storel_pi(reinterpret_cast<__m64*>(vertexDestination + stride * i), result[i]);
+                _mm_store_ss(vertexDestination + stride * i + 2, _mm_movehl_ps(result[i], result[i]));
+            }
+        }
+
+        transformScalar<TRANSLATE>(source + vertex * stride, destination + vertex * stride, count - vertex, stride, columns);
+    }
+
+    /**
+     * Transpose the 4x4 blocks in each 128-bit lane of 4 registers.
+     */
+    VERTEX_TRANSFORM_AVX_TARGET inline void transposeLanes(__m256& row0, __m256& row1, __m256& row2, __m256& row3)
+    {
+        __m256 t0 = _mm256_unpacklo_ps(row0, row1);
+        __m256 t1 = _mm256_unpackhi_ps(row0, row1);
+        __m256 t2 = _mm256_unpacklo_ps(row2, row3);
+        __m256 t3 = _mm256_unpackhi_ps(row2, row3);
+        row0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+        row1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        row2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+        row3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    }
+
+    /**
+     * Transform 8 vertices per iteration, vertices 0-3 in the low lanes and 4-7 in the high lanes.
+     * Multiplies and adds are kept separate (no FMA) so the results match the other paths.
+     */
+    template<bool TRANSLATE>
+    VERTEX_TRANSFORM_AVX_TARGET void transformAVX(const GLfloat* source, GLfloat* destination, size_t count, size_t stride, const TransformColumns& columns)
+    {
+        __m256 c[4][3];
+        for (int column = 0; column < 4; ++column) {
+            for (int row = 0; row < 3; ++row) {
+                c[column][row] = _mm256_set1_ps(columns.values[column][row]);
+            }
+        }
+
+        size_t vertex = 0;
+        for (; vertex + 8 <= count; vertex += 8) {
+            const GLfloat* vertexSource = source + vertex * stride;
+            GLfloat* vertexDestination = destination + vertex * stride;
+
+            __m256 rows[4];
+            for (int i = 0; i < 4; ++i) {
+                rows[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(vertexSource + stride * i)), _mm_loadu_ps(vertexSource + stride * (i + 4)), 1);
+            }
+            transposeLanes(rows[0], rows[1], rows[2], rows[3]);
+
+            __m256 result[4];
+            for (int row = 0; row < 3; ++row) {
+                __m256 xy = _mm256_add_ps(_mm256_mul_ps(c[0][row], rows[0]), _mm256_mul_ps(c[1][row], rows[1]));
+                __m256 zw = TRANSLATE ? _mm256_add_ps(_mm256_mul_ps(c[2][row], rows[2]), c[3][row]) : _mm256_mul_ps(c[2][row], rows[2]);
+                result[row] = _mm256_add_ps(xy, zw);
+            }
+            result[3] = _mm256_setzero_ps();
+            transposeLanes(result[0], result[1], result[2], result[3]);
+
+            // Only the 3 transformed floats of each vertex are written
+            for (int i = 0; i < 4; ++i) {
+                __m128 low = _mm256_castps256_ps128(result[i]);
+                __m128 high = _mm256_extractf128_ps(result[i], 1);
+                _mm_storel_pi(reinterpret_cast<__m64*>(vertexDestination + stride * i), low);
+                _mm_store_ss(vertexDestination + stride * i + 2, _mm_movehl_ps(low, low));
+                _mm_storel_pi(reinterpret_cast<__m64*>(vertexDestination + stride * (i + 4)), high);
+                _mm_store_ss(vertexDestination + stride * (i + 4) + 2, _mm_movehl_ps(high, high));
+            }
+        }
+
+        // Clear the upper halves before running SSE code, mixing them with dirty upper halves stalls
+        _mm256_zeroupper();
+        transformSSE<TRANSLATE>(source + vertex * stride, destination + vertex * stride, count - vertex, stride, columns);
+    }
+
+    VertexTransformPath detectPath()
+    {
+        int registers[4] = {};
+#ifdef _MSC_VER
+        __cpuid(registers, 1);
+#else
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            registers[2] = static_cast<int>(ecx);
+        }
+#endif
+
+        // AVX also needs the OS to save the upper halves of the registers (OSXSAVE, then XCR0 bits 1 and 2)
+        const int OSXSAVE_BIT = 1 << 27;
+        const int AVX_BIT = 1 << 28;
+        if ((registers[2] & OSXSAVE_BIT) && (registers[2] & AVX_BIT)) {
+#ifdef _MSC_VER
+            unsigned long long enabledState = _xgetbv(0);
+#else
+            unsigned int stateLow, stateHigh;
+            __asm__("xgetbv" : "=a"(stateLow), "=d"(stateHigh) : "c"(0));
+            unsigned long long enabledState = stateLow;
+#endif
+            if ((enabledState & 0x6) == 0x6) {
+                return VertexTransformPath::AVX;
+            }
+        }
+        return VertexTransformPath::SSE;
+    }
+#else
+    VertexTransformPath detectPath()
+    {
+        return VertexTransformPath::SCALAR;
+    }
+#endif
+
+    /**
+     * Transform the 3 floats at offset in each vertex with the fastest path that can read them.
+     */
+    template<bool TRANSLATE>
+    void transformAttribute(const GLfloat* source, GLfloat* destination, size_t count, size_t stride, size_t offset, const TransformColumns& columns)
+    {
+        source += offset;
+        destination += offset;
+
+#ifdef VERTEX_TRANSFORM_SSE
+        // The SIMD paths read 4 floats from each vertex
+        if (offset + 4 <= stride) {
+            if (VertexTransform::getPath() == VertexTransformPath::AVX) {
+                transformAVX<TRANSLATE>(source, destination, count, stride, columns);
+            }
+            else {
+                transformSSE<TRANSLATE>(source, destination, count, stride, columns);
+            }
+            return;
+        }
+#endif
+        transformScalar<TRANSLATE>(source, destination, count, stride, columns);
+    }
+}
+
+
+// ##################
+// #                #
+// # Public methods #
+// #                #
+// ##################
+
+
+// ##################
+// # Getter methods #
+// ##################
+
+
+VertexTransformPath VertexTransform::getPath()
+{
+    static const VertexTransformPath path = detectPath();
+    return path;
+}
+
+const char* VertexTransform::getPathName(VertexTransformPath path)
+{
+    switch (path) {
+    case VertexTransformPath::AVX:
+        return "AVX";
+    case VertexTransformPath::SSE:
+        return "SSE";
+    default:
+        return "scalar";
+    }
+}
+
+
+// #################
+// # Other methods #
+// #################
+
+
+void VertexTransform::transformVertices(std::span<const GLfloat> source, std::span<GLfloat> destination, VertexMode vertexMode, const glm::mat4& transform)
+{
+    // Attributes other than the position and normal are copied as they are
+    if (source.data() != destination.data()) {
+        std::copy(source.begin(), source.end(), destination.begin());
+    }
+
+    visitVertexFormat(vertexMode, [&](auto vertex) {
+        using VertexType = decltype(vertex);
+        const size_t stride = VertexType::FLOATS_PER_VERTEX;
+        const size_t count = source.size() / stride;
+
+        // Every vertex reads its own floats before writing them, so transforming in place is safe
+        transformAttribute<true>(source.data(), destination.data(), count, stride, VertexType::template getOffset<Position>(), getColumns(transform));
+
+        if constexpr (VertexType::template hasAttribute<Normal>()) {
+            // Normals keep perpendicular to the surface under non-uniform scale with the inverse transpose
+            glm::mat3 normalTransform = glm::mat3(glm::transpose(glm::inverse(transform)));
+            transformAttribute<false>(source.data(), destination.data(), count, stride, VertexType::template getOffset<Normal>(), getColumns(normalTransform));
+        }
+    });
+}
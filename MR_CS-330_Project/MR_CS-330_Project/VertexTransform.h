@@ -0,0 +1,63 @@
+// VertexTransform.h
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <span>
+#include "VertexFormat.h"
+
+// Enum for VertexTransformPath
+// The instruction set vertices are transformed with, chosen once from the CPU features
+enum VertexTransformPath {
+    SCALAR,                 // 1 vertex per iteration
+    SSE,                    // 4 vertices per iteration
+    AVX                     // 8 vertices per iteration
+};
+
+/**
+ * Class representing the batched transform of the positions and normals of interleaved vertices.
+ * Every path adds the products in the same order as glm's scalar matrix multiply, so all paths give identical results.
+ */
+class VertexTransform {
+public:
+    // Prevent construction, the transform holds no state
+    VertexTransform() = delete;
+
+
+    // ##################
+    // # Getter methods #
+    // ##################
+
+
+    /**
+     * Get the path vertices are transformed with on this CPU.
+     *
+     * @return The fastest path the CPU and OS support.
+     */
+    static VertexTransformPath getPath();
+
+    /**
+     * Get the name of a transform path, for logging.
+     *
+     * @param path The transform path.
+     * @return The name of the path.
+     */
+    static const char* getPathName(VertexTransformPath path);
+
+
+    // #################
+    // # Other methods #
+    // #################
+
+
+    /**
+     * Transform the positions (and normals, if the mode has them) of interleaved vertices.
+     * Normals are transformed by the inverse transpose, computed once. The source and destination may be the same.
+     *
+     * @param source The vertices to transform.
+     * @param destination The vertices to write, the same size as the source.
+     * @param vertexMode The vertex mode of the vertices.
+     * @param transform The transform to apply.
+     */
+    static void transformVertices(std::span<const GLfloat> source, std::span<GLfloat> destination, VertexMode vertexMode, const glm::mat4& transform);
+};